@@ -1,6 +1,6 @@
 #!/bin/bash
 
-BINS=(test_mpscq test_mpmcq test_mpmcqdd test_mpmcqsl test_dfmpscq test_dfmpmcq test_sfmpscq test_sfmpmcq stress_test_mpmc)
+BINS=(test_mpscq test_mpmcq test_mpmcqdd test_mpmcqsl test_mpmcqhp test_mpmcqtl test_dfmpscq test_dfmpmcq test_sfmpscq test_sfmpmcq stress_test_mpmc bench_spinlock bench_queues)
 [ ! -e ./log ] && mkdir ./log
 for FILE in "${BINS[@]}"; do
     BIN_FILE=./bin/${FILE}
@@ -2,7 +2,7 @@
 
 VG_OPTS="--xml=yes --tool=memcheck --leak-check=full --leak-resolution=high --show-leak-kinds=all --show-error-list=yes"
 VG_OPTS="$VG_OPTS --keep-debuginfo=yes --vgdb=no --track-origins=yes --num-callers=100"
-BINS=(test_mpscq test_mpmcq test_mpmcqdd test_mpmcqsl test_dfmpscq test_dfmpmcq test_sfmpscq test_sfmpmcq)
+BINS=(test_mpscq test_mpmcq test_mpmcqdd test_mpmcqsl test_mpmcqhp test_mpmcqtl test_dfmpscq test_dfmpmcq test_sfmpscq test_sfmpmcq)
 [ ! -e ./log ] && mkdir ./log
 for FILE in "${BINS[@]}"; do
     BIN_FILE=./bin/${FILE}
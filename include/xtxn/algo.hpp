@@ -3,55 +3,110 @@
 
 #pragma once
 
+#include <cassert>
+#include <cstdint>
 #include "types.hpp"
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h> // NOLINT
+#endif
 
 namespace xtxn {
+    /**
+     * Wrapping of an iteration counter at the bound B:
+     * modulo - the counter is reset to (next % B) and the result is taken modulo B;
+     * reduce - the counter is reduced below B by repeated subtraction, the result is reduced the same way;
+     * subtract - the counter is reset to (next - B) once, the result is reduced by repeated subtraction.
+     */
+    enum class wrap_policy { modulo, reduce, subtract };
+
+    template<size_t B, typename U>
+    requires (B > 1)
+    constexpr U wrap_reduce(U value) noexcept {
+        while (value >= static_cast<U>(B)) value -= static_cast<U>(B);
+        return value;
+    }
+
     /** Post-increment iteration **/
-    template<size_t B, any_atomic_uint T, typename U = T::value_type>
+    template<size_t B, wrap_policy W = wrap_policy::subtract, any_atomic_uint T, typename U = T::value_type>
     requires (B > 1)
     U iterate_post_inc(T & value) noexcept {
         U current { value.fetch_add(1, std::memory_order_relaxed) };
         U next { current + 1 };
         if (next >= static_cast<U>(B)) {
-    // v1 {{{
-            // value.compare_exchange_weak(next, next % static_cast<U>(B), std::memory_order_relaxed);
-    // }}} v1
-    // v2 {{{
-            // auto next2 = next - static_cast<U>(B);
-            // while (next2 >= static_cast<U>(B)) next2 -= static_cast<U>(B);
-            // value.compare_exchange_weak(next, next2, std::memory_order_relaxed);
-    // }}} v2
-    // v3 {{{
-            value.compare_exchange_weak(next, next - static_cast<U>(B), std::memory_order_relaxed);
-    // }}}
+            if constexpr (W == wrap_policy::modulo) {
+                value.compare_exchange_weak(next, next % static_cast<U>(B), std::memory_order_relaxed);
+            } else if constexpr (W == wrap_policy::reduce) {
+                value.compare_exchange_weak(next, wrap_reduce<B>(next), std::memory_order_relaxed);
+            } else {
+                value.compare_exchange_weak(next, next - static_cast<U>(B), std::memory_order_relaxed);
+            }
+        }
+        if constexpr (W == wrap_policy::modulo) {
+            return current >= static_cast<U>(B) ? current % static_cast<U>(B) : current;
+        } else {
+            return wrap_reduce<B>(current);
         }
-    // v1 {{{
-        // if (current >= static_cast<U>(B)) {
-        //     current = current % static_cast<U>(B);
-        // }
-    // }}} v1
-    // v2,3 {{{
-        while (current >= static_cast<U>(B)) current -= static_cast<U>(B);
-    // }}} v2,3
-        return current;
     }
 
     /** Pre-increment iteration **/
-    template<size_t B, any_atomic_uint T, typename U = T::value_type>
+    template<size_t B, wrap_policy W = wrap_policy::reduce, any_atomic_uint T, typename U = T::value_type>
     requires (B > 1)
     U iterate_pre_inc(T & value) noexcept {
         assert(value >= 0);
         U current { value.load(std::memory_order_relaxed) };
         U next;
         do {
-    // v1 {{{
-            // next = (current + 1) % static_cast<U>(B);
-    // }}} v1
-    // v2 {{{
-            next = current + 1;
-            while (next >= static_cast<U>(B)) next -= static_cast<U>(B);
-    // }}} v2
+            if constexpr (W == wrap_policy::modulo) {
+                next = (current + 1) % static_cast<U>(B);
+            } else {
+                next = wrap_reduce<B>(static_cast<U>(current + 1));
+            }
         } while (!value.compare_exchange_weak(current, next, std::memory_order_relaxed));
         return next;
     }
+
+    /**
+     * Modulo by a divisor known at run time only, computed from a precomputed reciprocal without a division
+     * (D. Lemire, O. Kaser, N. Kurz, "Faster Remainder by Direct Computation", 2019); exact for 32-bit values.
+     */
+    class fast_modulo {
+        uint64_t m_reciprocal;
+        uint32_t m_divisor;
+
+        static uint64_t mul_high(const uint64_t a, const uint64_t b) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return __umulh(a, b);
+#else
+            __extension__ using uint128_t = unsigned __int128;
+            return static_cast<uint64_t>((static_cast<uint128_t>(a) * b) >> 64);
+#endif
+        }
+
+    public:
+        explicit fast_modulo(const uint32_t divisor) noexcept
+        : m_reciprocal { UINT64_MAX / divisor + 1 }, m_divisor { divisor } {
+            assert(divisor > 0);
+        }
+
+        [[nodiscard]]
+        uint32_t divisor() const noexcept {
+            return m_divisor;
+        }
+
+        [[nodiscard]]
+        uint32_t operator()(const uint32_t value) const noexcept {
+            return static_cast<uint32_t>(mul_high(m_reciprocal * value, m_divisor));
+        }
+    };
+
+    /** Post-increment iteration with a bound known at run time, wrapped like the modulo policy **/
+    template<any_atomic_uint T, typename U = T::value_type>
+    U iterate_post_inc(T & value, const fast_modulo & bound) noexcept {
+        U current { value.fetch_add(1, std::memory_order_relaxed) };
+        U next { current + 1 };
+        if (next >= bound.divisor()) {
+            value.compare_exchange_weak(next, bound(static_cast<uint32_t>(next)), std::memory_order_relaxed);
+        }
+        return current >= bound.divisor() ? bound(static_cast<uint32_t>(current)) : current;
+    }
 }
@@ -0,0 +1,915 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Fast queue with the capacity chosen at construction. The slot states, the per-slot metadata and the payloads are
+ * placed in one contiguous region allocated up front (optionally on huge pages or a NUMA node, see
+ * fast_mpmc_queue_memory.hpp); the slot protocol and the accessors are the same as in static_fast_mpmc_queue. The
+ * cursors wrap at the run-time capacity with a modulo computed from a precomputed reciprocal.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <span>
+#include <utility>
+#include "types.hpp"
+#include "algo.hpp"
+#include "fast_mpmc_queue_commons.hpp"
+#include "fast_mpmc_queue_memory.hpp"
+#include "fast_mpmc_queue_lease.hpp"
+#include "fast_mpmc_queue_delivery.hpp"
+#include "fast_mpmc_queue_transfer.hpp"
+
+namespace xtxn {
+    template<
+        std::default_initializable T,
+        bool C = queue_default_auto_completion,
+        unsigned A = queue_default_attempts,
+        queue_stats_policy M = queue_no_stats,
+        queue_lease_policy E = queue_lease_policy::none,
+        unsigned R = queue_unlimited_deliveries,
+        queue_transfer_policy X = queue_transfer_policy::plain
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    class alignas(true_sharing_align) bounded_fast_mpmc_queue {
+        using slot_completion = queue_slot_completion<C>;
+        using slot_lock = queue_slot_lock<E>;
+        using ticket = typename slot_lock::ticket;
+        class producer_accessor;
+        class consumer_accessor;
+        class producer_span_accessor;
+        class consumer_span_accessor;
+        using mo = std::memory_order;
+        using state = queue_slot_state;
+        using transfer = queue_transfer<std::is_trivially_copyable_v<T> ? X : queue_transfer_policy::plain>;
+
+        struct alignas(false_sharing_align) {
+            std::atomic_uint_fast64_t m_index { 0 };
+            std::atomic_flag m_enable {};
+        } m_producer;
+        struct alignas(false_sharing_align) {
+            std::atomic_uint_fast64_t m_index { 0 };
+            std::atomic_flag m_enable {};
+        } m_consumer;
+        alignas(false_sharing_align) std::atomic_int_fast32_t m_free;
+        alignas(false_sharing_align) const int_fast32_t m_capacity;
+        const fast_modulo m_bound;
+        queue_memory_region m_region;
+        slot_lock * const m_state;
+        uint64_t * const m_stamps; /** publication timestamps, only if the residence time is measured **/
+        uint32_t * const m_deliveries; /** delivery counters, only with a delivery limit **/
+        T * const m_payload;
+        [[no_unique_address]] M m_stats {};
+        [[no_unique_address]] queue_lease<E> m_lease {};
+        [[no_unique_address]] queue_dead_letter<T, R> m_dead_letter {};
+
+        /** Offsets of the slot arrays in the region, the last one is the region size **/
+        struct layout {
+            size_t m_stamps;
+            size_t m_deliveries;
+            size_t m_payload;
+            size_t m_size;
+        };
+
+        static layout arrange(const size_t capacity) noexcept {
+            const auto align = [] (const size_t offset, const size_t alignment) {
+                return (offset + alignment - 1) / alignment * alignment;
+            };
+            const auto stamps = align(capacity * sizeof(slot_lock), false_sharing_align);
+            const auto deliveries = stamps + (M::c_residence ? capacity * sizeof(uint64_t) : 0);
+            const auto payload = align(
+                deliveries + (R > 0 ? capacity * sizeof(uint32_t) : 0), std::max(false_sharing_align, alignof(T))
+            );
+            return { stamps, deliveries, payload, payload + capacity * sizeof(T) };
+        }
+
+        template<typename U>
+        U * place(const size_t offset, const bool used = true) const noexcept {
+            return used ? reinterpret_cast<U *>(m_region.data() + offset) : nullptr;
+        }
+
+        void stamp(const size_t index) noexcept {
+            if constexpr (M::c_residence) {
+                m_stamps[index] = tsc_now();
+            }
+        }
+
+        uint64_t elapsed(const size_t index) const noexcept {
+            if constexpr (M::c_residence) {
+                return tsc_now() - m_stamps[index];
+            } else {
+                return 0;
+            }
+        }
+
+        void deliver(const size_t index) noexcept {
+            if constexpr (R > 0) {
+                ++m_deliveries[index];
+            }
+        }
+
+        void reset_deliveries(const size_t index) noexcept {
+            if constexpr (R > 0) {
+                m_deliveries[index] = 0;
+            }
+        }
+
+        uint32_t deliveries(const size_t index) const noexcept {
+            if constexpr (R > 0) {
+                return m_deliveries[index];
+            } else {
+                return 0;
+            }
+        }
+
+        queue_slot_status producer_failure() const noexcept {
+            if (!m_producer.m_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free.load(mo::acquire) ? queue_slot_status::contended : queue_slot_status::full;
+        }
+
+        queue_slot_status consumer_failure() const noexcept {
+            if (!m_consumer.m_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free.load(mo::acquire) < m_capacity ? queue_slot_status::contended : queue_slot_status::empty;
+        }
+
+        /** Locks up to count consecutive slots from the first one, rolls them back if fewer than least are locked **/
+        size_t lock_run(size_t first, size_t count, size_t least, state from, state to) noexcept;
+
+    public:
+        using payload_type [[maybe_unused]] = T;
+        using size_type = int32_t;
+        using offset_type = uint_fast64_t;
+
+        static constexpr offset_type c_invalid_index { std::numeric_limits<offset_type>::max() };
+        static constexpr bool c_auto_complete [[maybe_unused]] { C };
+        static constexpr unsigned c_default_attempts [[maybe_unused]] { A };
+        static constexpr bool c_stats [[maybe_unused]] { M::c_enabled };
+        static constexpr bool c_trace [[maybe_unused]] { M::c_trace };
+        static constexpr queue_lease_policy c_lease_policy [[maybe_unused]] { E };
+        static constexpr unsigned c_max_deliveries [[maybe_unused]] { R };
+        static constexpr bool c_contiguous [[maybe_unused]] {
+            std::is_trivially_copyable_v<T> && E == queue_lease_policy::none
+        };
+        static constexpr bool c_streaming [[maybe_unused]] {
+            std::is_trivially_copyable_v<T> && X == queue_transfer_policy::streaming
+        };
+
+        explicit bounded_fast_mpmc_queue(size_type capacity, const queue_memory_options & options = {});
+        bounded_fast_mpmc_queue(const bounded_fast_mpmc_queue &) = delete;
+        bounded_fast_mpmc_queue(bounded_fast_mpmc_queue &&) = delete;
+        ~bounded_fast_mpmc_queue();
+
+        bounded_fast_mpmc_queue & operator=(const bounded_fast_mpmc_queue &) = delete;
+        bounded_fast_mpmc_queue & operator=(bounded_fast_mpmc_queue &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        size_type capacity() const noexcept {
+            return static_cast<size_type>(m_capacity);
+        }
+
+        [[nodiscard, maybe_unused]]
+        size_type free_slots() const noexcept {
+            return static_cast<size_type>(m_free.load(mo::relaxed));
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool empty() const noexcept {
+            return m_free.load(mo::acquire) == m_capacity;
+        }
+
+        /** Whether the slots are backed by huge pages (hugetlb) or advised to be (transparent huge pages) **/
+        [[nodiscard, maybe_unused]]
+        bool huge_pages() const noexcept {
+            return m_region.huge_pages();
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool numa_bound() const noexcept {
+            return m_region.numa_bound();
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool producing() const noexcept {
+            return m_producer.m_enable.test(mo::acquire);
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool consuming() const noexcept {
+            return m_consumer.m_enable.test(mo::acquire);
+        }
+
+        [[nodiscard]] producer_accessor producer_slot(unsigned = c_default_attempts) noexcept;
+        [[nodiscard]] consumer_accessor consumer_slot(unsigned = 0) noexcept;
+
+        /** Claims a run of exactly count consecutive free slots, published together on release **/
+        [[nodiscard, maybe_unused]]
+        producer_span_accessor reserve_contiguous(size_type, unsigned = c_default_attempts) noexcept
+        requires (c_contiguous);
+
+        /** Claims a run of up to count consecutive ready slots, at least one **/
+        [[nodiscard, maybe_unused]]
+        consumer_span_accessor consume_contiguous(size_type, unsigned = 0) noexcept requires (c_contiguous);
+
+        [[nodiscard, maybe_unused]]
+        auto stats() const noexcept requires (M::c_enabled) {
+            return m_stats.snapshot();
+        }
+
+        [[nodiscard, maybe_unused]]
+        auto trace() const requires (M::c_trace) {
+            return m_stats.records();
+        }
+
+        [[maybe_unused]]
+        bool dump_trace(auto && target) const requires (M::c_trace) {
+            return m_stats.dump(target);
+        }
+
+        [[maybe_unused]]
+        void lease_duration(const std::chrono::nanoseconds duration)
+        noexcept requires (E == queue_lease_policy::timeout) {
+            m_lease.duration(duration);
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t reclaimed_leases() const noexcept requires (E == queue_lease_policy::timeout) {
+            return m_lease.reclaimed();
+        }
+
+        /** Sets the sink of items rejected after R deliveries, not to be changed while the queue is in use **/
+        [[maybe_unused]]
+        void dead_letter(std::function<bool(T &)> sink) noexcept requires (R > 0) {
+            m_dead_letter.sink(std::move(sink));
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t dead_letters() const noexcept requires (R > 0) {
+            return m_dead_letter.diverted();
+        }
+
+        /** Takes back the slots of expired leases: prod_locked ones become free, cons_locked ones ready **/
+        [[maybe_unused]] size_type reclaim_expired() noexcept requires (E == queue_lease_policy::timeout);
+
+        [[maybe_unused]]
+        void shutdown() noexcept {
+            m_producer.m_enable.clear(mo::release);
+        }
+
+        [[maybe_unused]]
+        void stop() noexcept {
+            m_producer.m_enable.clear(mo::release);
+            m_consumer.m_enable.clear(mo::release);
+        }
+    };
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    class bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::producer_accessor : public slot_completion {
+    protected:
+        bounded_fast_mpmc_queue * const m_queue { nullptr };
+        offset_type const m_index { c_invalid_index };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+        [[no_unique_address]] ticket m_ticket {};
+
+    public:
+        producer_accessor() = delete;
+
+        explicit producer_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
+        producer_accessor(const producer_accessor &) = delete;
+        producer_accessor(producer_accessor &&) = delete;
+
+        producer_accessor(bounded_fast_mpmc_queue * queue, offset_type index, const ticket & held) noexcept
+        : slot_completion {}, m_queue { queue }, m_index { index }, m_ticket { held } {
+            assert(m_queue);
+            assert(m_index < m_queue->m_bound.divisor());
+            assert(m_queue->m_state[m_index].load(mo::acquire) == state::prod_locked);
+            m_queue->m_free.fetch_sub(1, mo::acq_rel);
+        }
+
+        ~producer_accessor() override;
+
+        producer_accessor & operator=(const producer_accessor &) = delete;
+        producer_accessor & operator=(producer_accessor &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        T * operator->() noexcept {
+            assert(m_queue);
+            assert(m_index < m_queue->m_bound.divisor());
+            assert(m_queue->m_state[m_index].load(mo::acquire) == state::prod_locked);
+            return &m_queue->m_payload[m_index];
+        }
+
+        [[nodiscard, maybe_unused]]
+        T & operator*() noexcept {
+            assert(m_queue);
+            assert(m_index < m_queue->m_bound.divisor());
+            assert(m_queue->m_state[m_index].load(mo::acquire) == state::prod_locked);
+            return m_queue->m_payload[m_index];
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() noexcept {
+            assert(
+                (!m_queue && m_index == c_invalid_index)
+                || (
+                    m_queue && m_index < m_queue->m_bound.divisor()
+                    && m_queue->m_state[m_index].load(mo::acquire) == state::prod_locked
+                )
+            );
+            return m_queue;
+        }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+
+        /** Stores the item with non-temporal stores, bypassing the producer's cache **/
+        [[maybe_unused]]
+        void store(const T & item) noexcept requires (c_streaming) {
+            assert(m_queue);
+            transfer::store(m_queue->m_payload[m_index], item);
+        }
+
+        /** Extends the lease, fails if it has already been reclaimed **/
+        [[maybe_unused]]
+        bool renew() noexcept requires (E == queue_lease_policy::timeout) {
+            assert(m_queue);
+            return m_queue->m_state[m_index].renew(m_ticket, m_queue->m_lease);
+        }
+    };
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::producer_accessor::~producer_accessor() {
+        if (m_queue && m_queue->m_state[m_index].pin(m_ticket)) {
+            if constexpr (slot_completion::c_auto_complete) {
+                m_queue->stamp(m_index);
+                m_queue->m_stats.on_transition(m_index, state::prod_locked, state::ready);
+                m_queue->m_state[m_index].unlock(m_ticket, state::ready);
+            } else {
+                if (slot_completion::m_complete) {
+                    m_queue->stamp(m_index);
+                    m_queue->m_stats.on_transition(m_index, state::prod_locked, state::ready);
+                    m_queue->m_state[m_index].unlock(m_ticket, state::ready);
+                } else {
+                    m_queue->m_stats.on_transition(m_index, state::prod_locked, state::free);
+                    m_queue->m_state[m_index].unlock(m_ticket, state::free);
+                    m_queue->m_free.fetch_add(1, mo::acq_rel);
+                }
+            }
+        }
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    class bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::consumer_accessor : public slot_completion {
+    protected:
+        bounded_fast_mpmc_queue * const m_queue { nullptr };
+        offset_type const m_index { c_invalid_index };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+        [[no_unique_address]] ticket m_ticket {};
+
+    public:
+        consumer_accessor() = delete;
+
+        explicit consumer_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
+        consumer_accessor(const consumer_accessor &) = delete;
+        consumer_accessor(consumer_accessor &&) = delete;
+
+        consumer_accessor(bounded_fast_mpmc_queue * queue, offset_type index, const ticket & held) noexcept
+        : slot_completion {}, m_queue { queue }, m_index { index }, m_ticket { held } {
+            assert(m_queue);
+            assert(m_index < m_queue->m_bound.divisor());
+            assert(m_queue->m_state[m_index].load(mo::acquire) == state::cons_locked);
+        }
+
+        ~consumer_accessor() override;
+
+        consumer_accessor & operator=(const consumer_accessor &) = delete;
+        consumer_accessor & operator=(consumer_accessor &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        T * operator->() noexcept {
+            assert(m_queue);
+            assert(m_index < m_queue->m_bound.divisor());
+            assert(m_queue->m_state[m_index].load(mo::acquire) == state::cons_locked);
+            return &m_queue->m_payload[m_index];
+        }
+
+        [[nodiscard, maybe_unused]]
+        T & operator*() noexcept {
+            assert(m_queue);
+            assert(m_index < m_queue->m_bound.divisor());
+            assert(m_queue->m_state[m_index].load(mo::acquire) == state::cons_locked);
+            return m_queue->m_payload[m_index];
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() noexcept {
+            assert(
+                (!m_queue && m_index == c_invalid_index)
+                || (
+                    m_queue && m_index < m_queue->m_bound.divisor()
+                    && m_queue->m_state[m_index].load(mo::acquire) == state::cons_locked
+                )
+            );
+            return m_queue;
+        }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+
+        /** Extends the lease, fails if it has already been reclaimed **/
+        [[maybe_unused]]
+        bool renew() noexcept requires (E == queue_lease_policy::timeout) {
+            assert(m_queue);
+            return m_queue->m_state[m_index].renew(m_ticket, m_queue->m_lease);
+        }
+
+        /** How many times the item has been handed to a consumer, this time included **/
+        [[nodiscard, maybe_unused]]
+        unsigned deliveries() const noexcept requires (R > 0) {
+            assert(m_queue);
+            return m_queue->deliveries(m_index);
+        }
+    };
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::consumer_accessor::~consumer_accessor() {
+        if (m_queue && m_queue->m_state[m_index].pin(m_ticket)) {
+            if constexpr (slot_completion::c_auto_complete) {
+                m_queue->reset_deliveries(m_index);
+                m_queue->m_stats.on_transition(m_index, state::cons_locked, state::free);
+                m_queue->m_state[m_index].unlock(m_ticket, state::free);
+                m_queue->m_free.fetch_add(1, mo::acq_rel);
+            } else {
+                if (
+                    slot_completion::m_complete
+                    || m_queue->m_dead_letter.divert(m_queue->m_payload[m_index], m_queue->deliveries(m_index))
+                ) {
+                    m_queue->reset_deliveries(m_index);
+                    m_queue->m_stats.on_transition(m_index, state::cons_locked, state::free);
+                    m_queue->m_state[m_index].unlock(m_ticket, state::free);
+                    m_queue->m_free.fetch_add(1, mo::acq_rel);
+                } else {
+                    m_queue->m_stats.on_transition(m_index, state::cons_locked, state::ready);
+                    m_queue->m_state[m_index].unlock(m_ticket, state::ready);
+                }
+            }
+        }
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    class bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::producer_span_accessor : public slot_completion {
+    protected:
+        bounded_fast_mpmc_queue * const m_queue { nullptr };
+        size_t const m_first { 0 };
+        size_t const m_count { 0 };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+
+    public:
+        producer_span_accessor() = delete;
+
+        explicit producer_span_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
+        producer_span_accessor(const producer_span_accessor &) = delete;
+        producer_span_accessor(producer_span_accessor &&) = delete;
+
+        producer_span_accessor(bounded_fast_mpmc_queue * queue, size_t first, size_t count) noexcept
+        : slot_completion {}, m_queue { queue }, m_first { first }, m_count { count } {
+            assert(m_queue);
+            assert(m_count > 0 && m_first + m_count <= m_queue->m_bound.divisor());
+            m_queue->m_free.fetch_sub(static_cast<int_fast32_t>(m_count), mo::acq_rel);
+        }
+
+        ~producer_span_accessor() override;
+
+        producer_span_accessor & operator=(const producer_span_accessor &) = delete;
+        producer_span_accessor & operator=(producer_span_accessor &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        std::span<T> span() noexcept {
+            assert(m_queue);
+            return { &m_queue->m_payload[m_first], m_count };
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() noexcept {
+            return m_queue;
+        }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+    };
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::producer_span_accessor::~producer_span_accessor() {
+        if (m_queue) {
+            auto to = state::ready;
+            if constexpr (!slot_completion::c_auto_complete) {
+                if (!slot_completion::m_complete) {
+                    to = state::free;
+                }
+            }
+            for (auto index = m_first; index < m_first + m_count; ++index) {
+                if (to == state::ready) {
+                    m_queue->stamp(index);
+                }
+                m_queue->m_stats.on_transition(index, state::prod_locked, to);
+                m_queue->m_state[index].unlock(ticket {}, to);
+            }
+            if (to == state::free) {
+                m_queue->m_free.fetch_add(static_cast<int_fast32_t>(m_count), mo::acq_rel);
+            }
+        }
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    class bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::consumer_span_accessor : public slot_completion {
+    protected:
+        bounded_fast_mpmc_queue * const m_queue { nullptr };
+        size_t const m_first { 0 };
+        size_t const m_count { 0 };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+
+    public:
+        consumer_span_accessor() = delete;
+
+        explicit consumer_span_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
+        consumer_span_accessor(const consumer_span_accessor &) = delete;
+        consumer_span_accessor(consumer_span_accessor &&) = delete;
+
+        consumer_span_accessor(bounded_fast_mpmc_queue * queue, size_t first, size_t count) noexcept
+        : slot_completion {}, m_queue { queue }, m_first { first }, m_count { count } {
+            assert(m_queue);
+            assert(m_count > 0 && m_first + m_count <= m_queue->m_bound.divisor());
+        }
+
+        ~consumer_span_accessor() override;
+
+        consumer_span_accessor & operator=(const consumer_span_accessor &) = delete;
+        consumer_span_accessor & operator=(consumer_span_accessor &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        std::span<T> span() noexcept {
+            assert(m_queue);
+            return { &m_queue->m_payload[m_first], m_count };
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() noexcept {
+            return m_queue;
+        }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+    };
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::consumer_span_accessor::~consumer_span_accessor() {
+        if (m_queue) {
+            int_fast32_t freed { 0 };
+            for (auto index = m_first; index < m_first + m_count; ++index) {
+                auto to = state::free;
+                if constexpr (!slot_completion::c_auto_complete) {
+                    if (
+                        !slot_completion::m_complete
+                        && !m_queue->m_dead_letter.divert(m_queue->m_payload[index], m_queue->deliveries(index))
+                    ) {
+                        to = state::ready;
+                    }
+                }
+                if (to == state::free) {
+                    m_queue->reset_deliveries(index);
+                    ++freed;
+                }
+                m_queue->m_stats.on_transition(index, state::cons_locked, to);
+                m_queue->m_state[index].unlock(ticket {}, to);
+            }
+            if (freed) {
+                m_queue->m_free.fetch_add(freed, mo::acq_rel);
+            }
+        }
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::bounded_fast_mpmc_queue(
+        const size_type capacity,
+        const queue_memory_options & options
+    )
+    :   m_free { std::max(capacity, size_type { 2 }) },
+        m_capacity { m_free.load(mo::relaxed) },
+        m_bound { static_cast<uint32_t>(m_capacity) },
+        m_region { arrange(m_bound.divisor()).m_size, options },
+        m_state { place<slot_lock>(0) },
+        m_stamps { place<uint64_t>(arrange(m_bound.divisor()).m_stamps, M::c_residence) },
+        m_deliveries { place<uint32_t>(arrange(m_bound.divisor()).m_deliveries, R > 0) },
+        m_payload { place<T>(arrange(m_bound.divisor()).m_payload) } {
+        assert(capacity > 1);
+        const auto slots = static_cast<size_t>(m_capacity);
+        std::uninitialized_value_construct_n(m_state, slots);
+        if constexpr (M::c_residence) {
+            std::uninitialized_value_construct_n(m_stamps, slots);
+        }
+        if constexpr (R > 0) {
+            std::uninitialized_value_construct_n(m_deliveries, slots);
+        }
+        std::uninitialized_value_construct_n(m_payload, slots);
+        m_producer.m_enable.test_and_set(mo::acquire);
+        m_consumer.m_enable.test_and_set(mo::acquire);
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    auto
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::producer_slot(unsigned slot_acquire_attempts)
+    noexcept -> producer_accessor {
+        assert(slot_acquire_attempts > 0);
+
+        [[maybe_unused]] unsigned probes { 0 };
+
+        if (!m_producer.m_enable.test(mo::acquire)) {
+            m_stats.on_acquire(queue_side::producer, queue_slot_status::stopped, probes, m_capacity);
+            return producer_accessor { queue_slot_status::stopped };
+        }
+
+        do {
+            for (
+                auto count = m_capacity;
+                count && m_producer.m_enable.test(mo::acquire) && m_free.load(mo::acquire);
+                --count
+            ) {
+                ++probes;
+                ticket held {};
+                auto index = iterate_post_inc(m_producer.m_index, m_bound);
+                if (m_state[index].lock(state::free, state::prod_locked, held, m_lease)) {
+                    m_stats.on_transition(index, state::free, state::prod_locked);
+                    m_stats.on_acquire(queue_side::producer, queue_slot_status::acquired, probes, m_capacity);
+                    return { this, index, held };
+                }
+            }
+        } while (--slot_acquire_attempts);
+
+        const auto status = producer_failure();
+        m_stats.on_acquire(queue_side::producer, status, probes, m_capacity);
+        return producer_accessor { status };
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    auto
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::consumer_slot(unsigned slot_acquire_attempts)
+    noexcept -> consumer_accessor {
+        [[maybe_unused]] unsigned probes { 0 };
+
+        for (
+            auto budget = slot_acquire_attempts
+                ? static_cast<uint_fast64_t>(slot_acquire_attempts) * static_cast<uint_fast64_t>(m_capacity)
+                : std::numeric_limits<uint_fast64_t>::max();
+            budget && m_consumer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) < m_capacity;
+            --budget
+        ) {
+            ++probes;
+            ticket held {};
+            auto index = iterate_post_inc(m_consumer.m_index, m_bound);
+            if (m_state[index].lock(state::ready, state::cons_locked, held, m_lease)) {
+                m_stats.on_transition(index, state::ready, state::cons_locked);
+                deliver(index);
+                m_stats.on_acquire(queue_side::consumer, queue_slot_status::acquired, probes, m_capacity);
+                m_stats.on_residence(elapsed(index));
+                transfer::prefetch(m_payload[index + 1 < m_bound.divisor() ? index + 1 : 0]);
+                return { this, index, held };
+            }
+        }
+
+        const auto status = consumer_failure();
+        m_stats.on_acquire(queue_side::consumer, status, probes, m_capacity);
+        return consumer_accessor { status };
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    size_t bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::lock_run(
+        const size_t first, const size_t count, const size_t least, const state from, const state to
+    ) noexcept {
+        size_t locked { 0 };
+        for (ticket held {}; locked < count && m_state[first + locked].lock(from, to, held, m_lease); ++locked) {
+            m_stats.on_transition(first + locked, from, to);
+        }
+        if (locked < least) {
+            for (; locked; --locked) {
+                m_stats.on_transition(first + locked - 1, to, from);
+                m_state[first + locked - 1].unlock(ticket {}, from);
+            }
+        }
+        return locked;
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    auto
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::reserve_contiguous(
+        const size_type count, unsigned slot_acquire_attempts
+    ) noexcept -> producer_span_accessor requires (c_contiguous) {
+        assert(count > 0 && count <= m_capacity);
+        assert(slot_acquire_attempts > 0);
+
+        [[maybe_unused]] unsigned probes { 0 };
+
+        if (!m_producer.m_enable.test(mo::acquire)) {
+            m_stats.on_acquire(queue_side::producer, queue_slot_status::stopped, probes, m_capacity);
+            return producer_span_accessor { queue_slot_status::stopped };
+        }
+
+        const auto length = static_cast<size_t>(count);
+
+        do {
+            for (
+                auto round = m_capacity;
+                round && m_producer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) >= count;
+                --round
+            ) {
+                ++probes;
+                const auto first = static_cast<size_t>(iterate_post_inc(m_producer.m_index, m_bound));
+                if (
+                    first + length <= static_cast<size_t>(m_capacity)
+                    && lock_run(first, length, length, state::free, state::prod_locked)
+                ) {
+                    m_producer.m_index.fetch_add(length - 1, mo::relaxed);
+                    m_stats.on_acquire(queue_side::producer, queue_slot_status::acquired, probes, m_capacity);
+                    return { this, first, length };
+                }
+            }
+        } while (--slot_acquire_attempts);
+
+        const auto status = producer_failure();
+        m_stats.on_acquire(queue_side::producer, status, probes, m_capacity);
+        return producer_span_accessor { status };
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    auto
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::consume_contiguous(
+        const size_type count, unsigned slot_acquire_attempts
+    ) noexcept -> consumer_span_accessor requires (c_contiguous) {
+        assert(count > 0 && count <= m_capacity);
+
+        [[maybe_unused]] unsigned probes { 0 };
+
+        const auto length = static_cast<size_t>(count);
+
+        for (
+            auto budget = slot_acquire_attempts
+                ? static_cast<uint_fast64_t>(slot_acquire_attempts) * static_cast<uint_fast64_t>(m_capacity)
+                : std::numeric_limits<uint_fast64_t>::max();
+            budget && m_consumer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) < m_capacity;
+            --budget
+        ) {
+            ++probes;
+            const auto first = static_cast<size_t>(iterate_post_inc(m_consumer.m_index, m_bound));
+            const auto room = static_cast<size_t>(m_capacity) - first;
+            const auto locked = lock_run(first, room < length ? room : length, 1, state::ready, state::cons_locked);
+            if (locked) {
+                m_consumer.m_index.fetch_add(locked - 1, mo::relaxed);
+                for (auto index = first; index < first + locked; ++index) {
+                    deliver(index);
+                    m_stats.on_residence(elapsed(index));
+                }
+                m_stats.on_acquire(queue_side::consumer, queue_slot_status::acquired, probes, m_capacity);
+                return { this, first, locked };
+            }
+        }
+
+        const auto status = consumer_failure();
+        m_stats.on_acquire(queue_side::consumer, status, probes, m_capacity);
+        return consumer_span_accessor { status };
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    auto
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::reclaim_expired()
+    noexcept -> size_type requires (E == queue_lease_policy::timeout) {
+        size_type reclaimed { 0 };
+        const auto now = m_lease.now();
+
+        for (offset_type index { 0 }; index < m_bound.divisor(); ++index) {
+            if (const auto locked = m_state[index].reclaim(now); locked) {
+                if (*locked == state::prod_locked) {
+                    m_stats.on_transition(index, state::prod_locked, state::free);
+                    m_free.fetch_add(1, mo::acq_rel);
+                } else {
+                    m_stats.on_transition(index, state::cons_locked, state::ready);
+                }
+                m_lease.count_reclaimed();
+                ++reclaimed;
+            }
+        }
+
+        return reclaimed;
+    }
+
+    template<
+        std::default_initializable T, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+        queue_transfer_policy X
+    >
+    requires (A > 0) && queue_leasable_payload<T, E>
+    bounded_fast_mpmc_queue<T, C, A, M, E, R, X>::~bounded_fast_mpmc_queue() {
+        std::destroy_n(m_payload, static_cast<size_t>(m_capacity));
+        std::destroy_n(m_state, static_cast<size_t>(m_capacity));
+    }
+
+    template<class T>
+    concept any_bounded_fast_mpmc_queue = requires(T t) {
+        [] <
+            std::default_initializable U, bool C, unsigned A, queue_stats_policy M, queue_lease_policy E, unsigned R,
+            queue_transfer_policy X
+        >
+        (bounded_fast_mpmc_queue<U, C, A, M, E, R, X> &) {} (t);
+    };
+}
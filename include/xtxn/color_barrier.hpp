@@ -1,71 +1,207 @@
-// Copyright (c) 2025 Vitaly Anasenko
+// Copyright (c) 2025-2026 Vitaly Anasenko
 // Distributed under the MIT License, see accompanying file LICENSE.txt
 
+/**
+ * Two-color shared barrier. Any number of threads of the same color may pass it at once, while threads of different
+ * colors exclude each other. The green color is expected to be the common one: green threads are spread over K
+ * cache-line sized counters, so they do not contend on a single word. Waiting threads are parked with atomic wait.
+ * With the 'red' preference an announced red thread blocks new green threads and waits until the green counters drain,
+ * so red threads cannot be starved by a steady stream of green ones.
+ */
+
 #pragma once
 
+#include <cstdint>
 #include <atomic>
+#include <mutex>
 #include <thread>
+#if defined(__linux__)
+#   include <sched.h>
+#endif
+#include "types.hpp"
 
 namespace xtxn {
-    class color_barrier {
-        friend class red_lock;
-        friend class green_lock;
+    enum class color_preference { none, red };
+
+    constexpr unsigned color_barrier_default_shards [[maybe_unused]] { 0x10 };
+
+    template<class B> class red_lock;
+    template<class B> class green_lock;
+
+    template<color_preference P = color_preference::none, unsigned K = color_barrier_default_shards>
+    requires (K > 0)
+    class basic_color_barrier {
+        template<class B> friend class red_lock;
+        template<class B> friend class green_lock;
 
-        std::atomic_uint_fast64_t m_red_counter {};
-        std::atomic_uint_fast64_t m_green_counter {};
+        using mo = std::memory_order;
+        using counter_type = std::atomic_uint32_t;
+
+        struct alignas(false_sharing_align) shard {
+            counter_type m_counter { 0 };
+        };
+
+        alignas(false_sharing_align) counter_type m_red_counter { 0 };
+        shard m_green_counters[K] {};
+
+        static unsigned current_shard() noexcept {
+#if defined(__linux__)
+            if (const int cpu { ::sched_getcpu() }; cpu >= 0) {
+                return static_cast<unsigned>(cpu) % K;
+            }
+#endif
+            static std::atomic_uint s_next_shard { 0 };
+            thread_local const unsigned shard { s_next_shard.fetch_add(1, mo::relaxed) % K };
+            return shard;
+        }
+
+        bool greens_present() const noexcept {
+            for (auto & shard : m_green_counters) {
+                if (shard.m_counter.load(mo::seq_cst)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void wait_greens() const noexcept {
+            for (auto & shard : m_green_counters) {
+                for (auto value = shard.m_counter.load(mo::acquire); value; value = shard.m_counter.load(mo::acquire)) {
+                    shard.m_counter.wait(value, mo::acquire);
+                }
+            }
+        }
+
+        void wait_reds() const noexcept {
+            for (auto value = m_red_counter.load(mo::acquire); value; value = m_red_counter.load(mo::acquire)) {
+                m_red_counter.wait(value, mo::acquire);
+            }
+        }
+
+        void release_red() noexcept {
+            if (m_red_counter.fetch_sub(1, mo::acq_rel) == 1) {
+                m_red_counter.notify_all();
+            }
+        }
+
+        bool try_lock_red() noexcept {
+            m_red_counter.fetch_add(1, mo::seq_cst);
+            if (greens_present()) {
+                release_red();
+                return false;
+            }
+            return true;
+        }
+
+        void lock_red() noexcept {
+            if constexpr (P == color_preference::red) {
+                m_red_counter.fetch_add(1, mo::seq_cst);
+                wait_greens();
+            } else {
+                while (!try_lock_red()) {
+                    wait_greens();
+                }
+            }
+        }
+
+        void unlock_red() noexcept {
+            release_red();
+        }
+
+        unsigned lock_green() noexcept {
+            const unsigned index { current_shard() };
+            auto & counter = m_green_counters[index].m_counter;
+            for (;;) {
+                wait_reds();
+                counter.fetch_add(1, mo::seq_cst);
+                if (!m_red_counter.load(mo::seq_cst)) {
+                    return index;
+                }
+                unlock_green(index);
+            }
+        }
+
+        void unlock_green(const unsigned index) noexcept {
+            auto & counter = m_green_counters[index].m_counter;
+            // Without the preference a waiting red thread has already withdrawn from m_red_counter, so a drained shard
+            // is always announced.
+            if (counter.fetch_sub(1, mo::seq_cst) == 1
+                && (P == color_preference::none || m_red_counter.load(mo::seq_cst))) {
+                counter.notify_all();
+            }
+        }
 
     public:
-        color_barrier() noexcept = default;
-        color_barrier(const color_barrier &) = delete;
-        color_barrier(color_barrier &&) = delete;
-        ~color_barrier() noexcept = default;
+        static constexpr color_preference c_preference [[maybe_unused]] { P };
+        static constexpr unsigned c_shards [[maybe_unused]] { K };
+
+        basic_color_barrier() noexcept = default;
+        basic_color_barrier(const basic_color_barrier &) = delete;
+        basic_color_barrier(basic_color_barrier &&) = delete;
+        ~basic_color_barrier() noexcept = default;
 
-        color_barrier & operator=(const color_barrier &) = delete;
-        color_barrier & operator=(color_barrier &&) = delete;
+        basic_color_barrier & operator=(const basic_color_barrier &) = delete;
+        basic_color_barrier & operator=(basic_color_barrier &&) = delete;
     };
 
+    using color_barrier = basic_color_barrier<>;
+
+    template<class B = color_barrier>
     class red_lock {
-        color_barrier & m_color_barrier;
+        B & m_color_barrier;
+        bool m_owns { false };
 
     public:
         red_lock() = delete;
         red_lock(const red_lock &) = delete;
         red_lock(red_lock &&) = delete;
 
-        explicit red_lock(color_barrier & barrier) noexcept
+        explicit red_lock(B & barrier) noexcept
         : m_color_barrier { barrier } {
-            while (m_color_barrier.m_green_counter.load(std::memory_order_acquire)) {
-                std::this_thread::yield();
-            }
-            m_color_barrier.m_red_counter.fetch_add(1, std::memory_order_acq_rel);
+            m_color_barrier.lock_red();
+            m_owns = true;
+        }
+
+        red_lock(B & barrier, std::try_to_lock_t) noexcept
+        : m_color_barrier { barrier } {
+            m_owns = m_color_barrier.try_lock_red();
         }
 
         ~red_lock() noexcept {
-            m_color_barrier.m_red_counter.fetch_sub(1, std::memory_order_acq_rel);
+            if (m_owns) {
+                m_color_barrier.unlock_red();
+            }
         }
 
         red_lock & operator=(const red_lock &) = delete;
         red_lock & operator=(red_lock &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        bool owns_lock() const noexcept {
+            return m_owns;
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() const noexcept {
+            return m_owns;
+        }
     };
 
+    template<class B = color_barrier>
     class green_lock {
-        color_barrier & m_color_barrier;
+        B & m_color_barrier;
+        const unsigned m_shard;
 
     public:
         green_lock() = delete;
         green_lock(const green_lock &) = delete;
         green_lock(green_lock &&) = delete;
 
-        explicit green_lock(color_barrier & barrier) noexcept
-        : m_color_barrier { barrier } {
-            while (m_color_barrier.m_red_counter.load(std::memory_order_acquire)) {
-                std::this_thread::yield();
-            }
-            m_color_barrier.m_green_counter.fetch_add(1, std::memory_order_acq_rel);
-        }
+        explicit green_lock(B & barrier) noexcept
+        : m_color_barrier { barrier }, m_shard { m_color_barrier.lock_green() } {}
 
         ~green_lock() noexcept {
-            m_color_barrier.m_green_counter.fetch_sub(1, std::memory_order_acq_rel);
+            m_color_barrier.unlock_green(m_shard);
         }
 
         green_lock & operator=(const green_lock &) = delete;
@@ -4,28 +4,48 @@
 #pragma once
 
 #include <cassert>
+#include <chrono>
 #include <concepts>
+#include <limits>
 #include <mutex>
+#include <utility>
 #include "types.hpp"
 #include "fast_mpmc_queue_commons.hpp"
+#include "fast_mpmc_queue_lease.hpp"
+#include "fast_mpmc_queue_delivery.hpp"
 #include "spinlock.hpp"
 
 namespace xtxn {
     enum class queue_growth_policy { call, round, step };
 
+    /**
+     * Advancing of the shared slot cursor:
+     * exchange - the cursor is exchanged with the next slot of its current value;
+     * store - the cursor is loaded and the next slot is stored (a racing thread may probe the same slot);
+     * cas - the cursor is advanced with a CAS from the last seen slot; after a failed CAS the observed slot is probed
+     *       without moving the cursor.
+     */
+    enum class queue_cursor_policy { exchange, store, cas };
+
     template<
         std::default_initializable T,
         signed S = queue_default_block_size,
         signed L = queue_default_max_blocks,
         bool C = queue_default_auto_completion,
         unsigned A = queue_default_attempts,
-        queue_growth_policy G = queue_growth_policy::round
+        queue_growth_policy G = queue_growth_policy::round,
+        queue_stats_policy M = queue_no_stats,
+        queue_cursor_policy K = queue_cursor_policy::store,
+        queue_lease_policy E = queue_lease_policy::none,
+        unsigned R = queue_unlimited_deliveries
     >
-    requires (S > 1) && (L > 0) && (A > 0)
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
     class alignas(true_sharing_align) dynamic_fast_mpmc_queue {
         struct slot;
         struct block;
         using slot_completion = queue_slot_completion<C>;
+        using slot_lock = queue_slot_lock<E>;
+        using ticket = typename slot_lock::ticket;
         class producer_accessor;
         class consumer_accessor;
         using mo = std::memory_order;
@@ -46,9 +66,51 @@ namespace xtxn {
             std::atomic_flag m_enable {};
         } m_consumer;
         alignas(false_sharing_align) std::atomic_int_fast32_t m_free { 0 };
+        [[no_unique_address]] M m_stats {};
+        [[no_unique_address]] queue_lease<E> m_lease {};
+        [[no_unique_address]] queue_dead_letter<T, R> m_dead_letter {};
 
         bool grow() noexcept;
 
+        /** Takes the slot to probe and moves the cursor on, 'seen' is the last observed cursor (cas policy only) **/
+        static slot * advance(std::atomic<slot *> & cursor, [[maybe_unused]] slot *& seen) noexcept {
+            if constexpr (K == queue_cursor_policy::exchange) {
+                return cursor.exchange(cursor.load(mo::acquire)->m_next, mo::acq_rel);
+            } else if constexpr (K == queue_cursor_policy::store) {
+                auto current = cursor.load(mo::acquire);
+                cursor.store(current->m_next, mo::release);
+                return current;
+            } else {
+                auto current = seen;
+                if (cursor.compare_exchange_strong(seen, current->m_next, mo::acq_rel, mo::acquire)) {
+                    seen = current->m_next;
+                    return current;
+                }
+                return seen;
+            }
+        }
+
+        /** Slots are identified in a trace by their addresses **/
+        static uintptr_t trace_id(const slot * target) noexcept {
+            return reinterpret_cast<uintptr_t>(target);
+        }
+
+        queue_slot_status producer_failure() const noexcept {
+            if (!m_producer.m_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free.load(mo::acquire) ? queue_slot_status::contended : queue_slot_status::full;
+        }
+
+        queue_slot_status consumer_failure() const noexcept {
+            if (!m_consumer.m_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free.load(mo::acquire) < m_capacity.load(mo::acquire)
+                ? queue_slot_status::contended
+                : queue_slot_status::empty;
+        }
+
     public:
         using payload_type [[maybe_unused]] = T;
         using size_type = decltype(m_capacity)::value_type;
@@ -58,6 +120,11 @@ namespace xtxn {
         static constexpr bool c_auto_complete [[maybe_unused]] { C };
         static constexpr unsigned c_default_attempts [[maybe_unused]] { A };
         static constexpr queue_growth_policy c_growth_policy [[maybe_unused]] { G };
+        static constexpr queue_cursor_policy c_cursor_policy [[maybe_unused]] { K };
+        static constexpr bool c_stats [[maybe_unused]] { M::c_enabled };
+        static constexpr bool c_trace [[maybe_unused]] { M::c_trace };
+        static constexpr queue_lease_policy c_lease_policy [[maybe_unused]] { E };
+        static constexpr unsigned c_max_deliveries [[maybe_unused]] { R };
 
         dynamic_fast_mpmc_queue();
         dynamic_fast_mpmc_queue(const dynamic_fast_mpmc_queue &) = delete;
@@ -93,7 +160,47 @@ namespace xtxn {
         }
 
         [[nodiscard]] producer_accessor producer_slot(unsigned = c_default_attempts) noexcept;
-        [[nodiscard]] consumer_accessor consumer_slot() noexcept;
+        [[nodiscard]] consumer_accessor consumer_slot(unsigned = 0) noexcept;
+
+        [[nodiscard, maybe_unused]]
+        auto stats() const noexcept requires (M::c_enabled) {
+            return m_stats.snapshot();
+        }
+
+        [[nodiscard, maybe_unused]]
+        auto trace() const requires (M::c_trace) {
+            return m_stats.records();
+        }
+
+        [[maybe_unused]]
+        bool dump_trace(auto && target) const requires (M::c_trace) {
+            return m_stats.dump(target);
+        }
+
+        [[maybe_unused]]
+        void lease_duration(const std::chrono::nanoseconds duration)
+        noexcept requires (E == queue_lease_policy::timeout) {
+            m_lease.duration(duration);
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t reclaimed_leases() const noexcept requires (E == queue_lease_policy::timeout) {
+            return m_lease.reclaimed();
+        }
+
+        /** Sets the sink of items rejected after R deliveries, not to be changed while the queue is in use **/
+        [[maybe_unused]]
+        void dead_letter(std::function<bool(T &)> sink) noexcept requires (R > 0) {
+            m_dead_letter.sink(std::move(sink));
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t dead_letters() const noexcept requires (R > 0) {
+            return m_dead_letter.diverted();
+        }
+
+        /** Takes back the slots of expired leases: prod_locked ones become free, cons_locked ones ready **/
+        [[maybe_unused]] size_type reclaim_expired() noexcept requires (E == queue_lease_policy::timeout);
 
         [[maybe_unused]]
         void shutdown() noexcept {
@@ -107,11 +214,16 @@ namespace xtxn {
         }
     };
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    struct dynamic_fast_mpmc_queue<T, S, L, C, A, G>::slot {
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    struct dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::slot {
         slot * m_next { nullptr };
-        alignas(false_sharing_align) std::atomic<state> m_state { state::free };
+        alignas(false_sharing_align) slot_lock m_state {};
+        [[no_unique_address]] queue_slot_stamps<M::c_residence> m_stamp {};
+        [[no_unique_address]] queue_slot_deliveries<(R > 0)> m_deliveries {};
         alignas(false_sharing_align) T m_payload {};
 
         slot() noexcept(c_ntdct) = default;
@@ -123,9 +235,12 @@ namespace xtxn {
         slot & operator=(slot &&) = delete;
     };
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    struct dynamic_fast_mpmc_queue<T, S, L, C, A, G>::block {
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    struct dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::block {
         slot m_slots[static_cast<size_t>(S)] {};
         block * m_next { nullptr };
 
@@ -159,20 +274,31 @@ namespace xtxn {
         }
     };
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    class dynamic_fast_mpmc_queue<T, S, L, C, A, G>::producer_accessor : public slot_completion {
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    class dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::producer_accessor : public slot_completion {
     protected:
         dynamic_fast_mpmc_queue * const m_queue { nullptr };
         slot * const m_slot { nullptr };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+        [[no_unique_address]] ticket m_ticket {};
 
     public:
-        producer_accessor() noexcept = default;
+        producer_accessor() = delete;
+
+        explicit producer_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
         producer_accessor(const producer_accessor &) = delete;
         producer_accessor(producer_accessor &&) = delete;
 
-        producer_accessor(dynamic_fast_mpmc_queue * queue, slot * slot) noexcept
-        : slot_completion {}, m_queue { queue }, m_slot { slot } {
+        producer_accessor(dynamic_fast_mpmc_queue * queue, slot * slot, const ticket & held) noexcept
+        : slot_completion {}, m_queue { queue }, m_slot { slot }, m_ticket { held } {
             assert(m_queue);
             assert(m_slot);
             assert(m_slot->m_state.load(mo::acquire) == state::prod_locked);
@@ -208,39 +334,70 @@ namespace xtxn {
             );
             return m_slot;
         }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+
+        /** Extends the lease, fails if it has already been reclaimed **/
+        [[maybe_unused]]
+        bool renew() noexcept requires (E == queue_lease_policy::timeout) {
+            assert(m_slot);
+            return m_slot->m_state.renew(m_ticket, m_queue->m_lease);
+        }
     };
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    dynamic_fast_mpmc_queue<T, S, L, C, A, G>::producer_accessor::~producer_accessor() {
-        if (m_slot) {
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::producer_accessor::~producer_accessor() {
+        if (m_slot && m_slot->m_state.pin(m_ticket)) {
             if constexpr (slot_completion::c_auto_complete) {
-                m_slot->m_state.store(state::ready, mo::release);
+                m_slot->m_stamp.stamp();
+                m_queue->m_stats.on_transition(trace_id(m_slot), state::prod_locked, state::ready);
+                m_slot->m_state.unlock(m_ticket, state::ready);
             } else {
                 if (slot_completion::m_complete) {
-                    m_slot->m_state.store(state::ready, mo::release);
+                    m_slot->m_stamp.stamp();
+                    m_queue->m_stats.on_transition(trace_id(m_slot), state::prod_locked, state::ready);
+                    m_slot->m_state.unlock(m_ticket, state::ready);
                 } else {
-                    m_slot->m_state.store(state::free, mo::release);
+                    m_queue->m_stats.on_transition(trace_id(m_slot), state::prod_locked, state::free);
+                    m_slot->m_state.unlock(m_ticket, state::free);
                     m_queue->m_free.fetch_add(1, mo::acq_rel);
                 }
             }
         }
     }
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    class dynamic_fast_mpmc_queue<T, S, L, C, A, G>::consumer_accessor : public slot_completion {
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    class dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::consumer_accessor : public slot_completion {
     protected:
         dynamic_fast_mpmc_queue * const m_queue { nullptr };
         slot * const m_slot { nullptr };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+        [[no_unique_address]] ticket m_ticket {};
 
     public:
-        consumer_accessor() noexcept = default;
+        consumer_accessor() = delete;
+
+        explicit consumer_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
         consumer_accessor(const consumer_accessor &) = delete;
         consumer_accessor(consumer_accessor &&) = delete;
 
-        consumer_accessor(dynamic_fast_mpmc_queue * queue, slot * slot) noexcept
-        : slot_completion {}, m_queue { queue }, m_slot { slot } {
+        consumer_accessor(dynamic_fast_mpmc_queue * queue, slot * slot, const ticket & held) noexcept
+        : slot_completion {}, m_queue { queue }, m_slot { slot }, m_ticket { held } {
             assert(m_queue);
             assert(m_slot);
             assert(m_slot->m_state.load(mo::acquire) == state::cons_locked);
@@ -275,29 +432,62 @@ namespace xtxn {
             );
             return m_slot;
         }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+
+        /** Extends the lease, fails if it has already been reclaimed **/
+        [[maybe_unused]]
+        bool renew() noexcept requires (E == queue_lease_policy::timeout) {
+            assert(m_slot);
+            return m_slot->m_state.renew(m_ticket, m_queue->m_lease);
+        }
+
+        /** How many times the item has been handed to a consumer, this time included **/
+        [[nodiscard, maybe_unused]]
+        unsigned deliveries() const noexcept requires (R > 0) {
+            assert(m_slot);
+            return m_slot->m_deliveries.count();
+        }
     };
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    dynamic_fast_mpmc_queue<T, S, L, C, A, G>::consumer_accessor::~consumer_accessor() {
-        if (m_slot) {
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::consumer_accessor::~consumer_accessor() {
+        if (m_slot && m_slot->m_state.pin(m_ticket)) {
             if constexpr (slot_completion::c_auto_complete) {
-                m_slot->m_state.store(state::free, mo::release);
+                m_slot->m_deliveries.reset();
+                m_queue->m_stats.on_transition(trace_id(m_slot), state::cons_locked, state::free);
+                m_slot->m_state.unlock(m_ticket, state::free);
                 m_queue->m_free.fetch_add(1, mo::acq_rel);
             } else {
-                if (slot_completion::m_complete) {
-                    m_slot->m_state.store(state::free, mo::release);
+                if (
+                    slot_completion::m_complete
+                    || m_queue->m_dead_letter.divert(m_slot->m_payload, m_slot->m_deliveries.count())
+                ) {
+                    m_slot->m_deliveries.reset();
+                    m_queue->m_stats.on_transition(trace_id(m_slot), state::cons_locked, state::free);
+                    m_slot->m_state.unlock(m_ticket, state::free);
                     m_queue->m_free.fetch_add(1, mo::acq_rel);
                 } else {
-                    m_slot->m_state.store(state::ready, mo::release);
+                    m_queue->m_stats.on_transition(trace_id(m_slot), state::cons_locked, state::ready);
+                    m_slot->m_state.unlock(m_ticket, state::ready);
                 }
             }
         }
     }
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    dynamic_fast_mpmc_queue<T, S, L, C, A, G>::dynamic_fast_mpmc_queue()
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::dynamic_fast_mpmc_queue()
     :   m_first_block { new block }, m_last_block { m_first_block } {
         slot * first_slot { m_first_block->assemble() };
         m_producer.m_cursor.store(first_slot, mo::relaxed);
@@ -308,93 +498,128 @@ namespace xtxn {
         m_consumer.m_enable.test_and_set(mo::acquire);
     }
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    dynamic_fast_mpmc_queue<T, S, L, C, A, G>::~dynamic_fast_mpmc_queue() {
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::~dynamic_fast_mpmc_queue() {
         delete m_first_block;
     }
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
     auto
-    dynamic_fast_mpmc_queue<T, S, L, C, A, G>::producer_slot(unsigned acquire_attempts)
+    dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::producer_slot(unsigned acquire_attempts)
     noexcept -> producer_accessor {
+        [[maybe_unused]] unsigned probes { 0 };
+        const auto fail = [this, & probes] (const queue_slot_status status) -> producer_accessor {
+            if constexpr (M::c_enabled) {
+                m_stats.on_acquire(queue_side::producer, status, probes, capacity());
+            }
+            return producer_accessor { status };
+        };
+
         if (!m_producer.m_enable.test(mo::acquire)) {
-            return {};
+            return fail(queue_slot_status::stopped);
         }
         if (m_free.load(mo::acquire) == 0 && (m_capacity.load(mo::acquire) >= S * L || !grow())) {
-            return {};
+            return fail(queue_slot_status::full);
         }
 
-        // v3 {{{
-        // auto current = m_producerCursor.load(MemOrd::acquire);
-        // }}} v3
+        slot * seen { K == queue_cursor_policy::cas ? m_producer.m_cursor.load(mo::acquire) : nullptr };
         for (;;) {
             for (auto count = m_capacity.load(mo::acquire); count; --count) {
-                auto state = state::free;
-        // v1 {{{
-                // auto current = m_producer.m_cursor.exchange(m_producer.m_cursor.load(mo::acquire)->m_next, mo::acq_rel);
-        // }}} v1
-        // v2 {{{
-                auto current = m_producer.m_cursor.load(mo::acquire);
-                m_producer.m_cursor.store(current->m_next, mo::release);
-        // }}} v2
-        // v3 {{{
-                // m_producer.m_cursor.compare_exchange_strong(current, current->m_next, mo::acq_rel, mo::acquire);
-        // }}} v3
-                if (current->m_state.compare_exchange_strong(state, state::prod_locked, mo::acq_rel, mo::acquire)) {
-                    return { this, current };
+                ++probes;
+                ticket held {};
+                auto current = advance(m_producer.m_cursor, seen);
+                if (current->m_state.lock(state::free, state::prod_locked, held, m_lease)) {
+                    m_stats.on_transition(trace_id(current), state::free, state::prod_locked);
+                    if constexpr (M::c_enabled) {
+                        m_stats.on_acquire(queue_side::producer, queue_slot_status::acquired, probes, capacity());
+                    }
+                    return { this, current, held };
                 }
                 if (!m_producer.m_enable.test(mo::acquire)) {
-                    return {};
+                    return fail(queue_slot_status::stopped);
                 }
                 if constexpr (G == queue_growth_policy::step) {
                     if (m_free.load(mo::acquire) == 0 && (m_capacity.load(mo::acquire) >= S * L || !grow())) {
-                        return {};
+                        return fail(queue_slot_status::full);
                     }
                 }
             }
             if (!--acquire_attempts) {
-                return {};
+                return fail(producer_failure());
             }
             if constexpr (G == queue_growth_policy::round) {
                 if (m_free.load(mo::acquire) == 0 && (m_capacity.load(mo::acquire) >= S * L || !grow())) {
-                    return {};
+                    return fail(queue_slot_status::full);
                 }
             }
         }
     }
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    auto dynamic_fast_mpmc_queue<T, S, L, C, A, G>::consumer_slot() noexcept -> consumer_accessor {
-        // v3 {{{
-        // auto current = m_consumerCursor.load(MemOrd::acquire);
-        // }}} v3
-        while (m_consumer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) < m_capacity.load(mo::acquire)) {
-            auto state = state::ready;
-        // v1 {{{
-            // auto current = m_consumer.m_cursor.exchange(m_consumer.m_cursor.load(mo::acquire)->m_next, mo::acq_rel);
-        // }}} v1
-        // v2 {{{
-            auto current = m_consumer.m_cursor.load(mo::acquire);
-            m_consumer.m_cursor.store(current->m_next, mo::release);
-        // }}} v2
-        // v3 {{{
-            // m_consumer.m_cursor.compare_exchange_strong(current, current->m_next, mo::acq_rel, mo::acquire);
-        // }}} v3
-            if (current->m_state.compare_exchange_strong(state, state::cons_locked, mo::acq_rel, mo::acquire)) {
-                return { this, current };
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    auto
+    dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::consumer_slot(unsigned acquire_attempts)
+    noexcept -> consumer_accessor {
+        [[maybe_unused]] unsigned probes { 0 };
+        slot * seen { K == queue_cursor_policy::cas ? m_consumer.m_cursor.load(mo::acquire) : nullptr };
+
+        for (
+            auto budget = acquire_attempts
+                ? static_cast<uint_fast64_t>(acquire_attempts)
+                    * static_cast<uint_fast64_t>(m_capacity.load(mo::acquire))
+                : std::numeric_limits<uint_fast64_t>::max();
+            budget
+                && m_consumer.m_enable.test(mo::acquire)
+                && m_free.load(mo::acquire) < m_capacity.load(mo::acquire);
+            --budget
+        ) {
+            ++probes;
+            ticket held {};
+            auto current = advance(m_consumer.m_cursor, seen);
+            if (current->m_state.lock(state::ready, state::cons_locked, held, m_lease)) {
+                m_stats.on_transition(trace_id(current), state::ready, state::cons_locked);
+                current->m_deliveries.deliver();
+                if constexpr (M::c_enabled) {
+                    m_stats.on_acquire(queue_side::consumer, queue_slot_status::acquired, probes, capacity());
+                }
+                m_stats.on_residence(current->m_stamp.elapsed());
+                return { this, current, held };
             }
         }
 
-        return {};
+        const auto status = consumer_failure();
+        if constexpr (M::c_enabled) {
+            m_stats.on_acquire(queue_side::consumer, status, probes, capacity());
+        }
+        return consumer_accessor { status };
     }
 
-    template<std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G>
-    requires (S > 1) && (L > 0) && (A > 0)
-    bool dynamic_fast_mpmc_queue<T, S, L, C, A, G>::grow() noexcept {
-        std::scoped_lock lock { m_spinlock };
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    bool dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::grow() noexcept {
+        if constexpr (M::c_enabled) {
+            if (!m_spinlock.try_lock()) {
+                m_stats.on_lock_contended();
+                m_spinlock.lock();
+            }
+        } else {
+            m_spinlock.lock();
+        }
+        std::scoped_lock lock { std::adopt_lock, m_spinlock };
 
         if (m_free.load(mo::acquire)) {
             return true;
@@ -407,6 +632,7 @@ namespace xtxn {
         } catch (...) {
             last_slot->m_next = m_first_block->first_slot();
             m_last_block->m_next = nullptr;
+            m_stats.on_grow(false);
             return false;
         }
 
@@ -414,12 +640,47 @@ namespace xtxn {
         m_capacity.fetch_add(S, mo::release);
         m_free.fetch_add(S, mo::acq_rel);
         m_producer.m_cursor.store(last_slot->m_next, mo::release);
+        m_stats.on_grow(true);
         return true;
     }
 
+    template<
+        std::default_initializable T, signed S, signed L, bool C, unsigned A, queue_growth_policy G,
+        queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+    >
+    requires (S > 1) && (L > 0) && (A > 0) && queue_leasable_payload<T, E>
+    auto
+    dynamic_fast_mpmc_queue<T, S, L, C, A, G, M, K, E, R>::reclaim_expired()
+    noexcept -> size_type requires (E == queue_lease_policy::timeout) {
+        size_type reclaimed { 0 };
+        const auto now = m_lease.now();
+
+        // The block list is only linked under the growth lock
+        std::scoped_lock lock { m_spinlock };
+        for (auto current = m_first_block; current; current = current->m_next) {
+            for (auto & target : current->m_slots) {
+                if (const auto locked = target.m_state.reclaim(now); locked) {
+                    if (*locked == state::prod_locked) {
+                        m_stats.on_transition(trace_id(&target), state::prod_locked, state::free);
+                        m_free.fetch_add(1, mo::acq_rel);
+                    } else {
+                        m_stats.on_transition(trace_id(&target), state::cons_locked, state::ready);
+                    }
+                    m_lease.count_reclaimed();
+                    ++reclaimed;
+                }
+            }
+        }
+
+        return reclaimed;
+    }
+
     template<class T>
     concept any_dynamic_fast_mpmc_queue = requires(T t) {
-        [] <std::default_initializable U, int32_t S, int32_t L, bool C, unsigned A, queue_growth_policy G>
-        (dynamic_fast_mpmc_queue<U, S, L, C, A, G> &) {} (t);
+        [] <
+            std::default_initializable U, int32_t S, int32_t L, bool C, unsigned A, queue_growth_policy G,
+            queue_stats_policy M, queue_cursor_policy K, queue_lease_policy E, unsigned R
+        >
+        (dynamic_fast_mpmc_queue<U, S, L, C, A, G, M, K, E, R> &) {} (t);
     };
 }
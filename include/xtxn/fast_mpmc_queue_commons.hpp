@@ -4,7 +4,10 @@
 #pragma once
 
 #include <type_traits>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include "latency_histogram.hpp"
 
 namespace xtxn {
     constexpr int32_t queue_default_block_size [[maybe_unused]] { 0x10 };
@@ -13,6 +16,65 @@ namespace xtxn {
     constexpr unsigned queue_default_attempts [[maybe_unused]] { 5 };
 
     enum class queue_slot_state { free, prod_locked, ready, cons_locked };
+    enum class queue_slot_status { acquired, full, stopped, contended, empty };
+    enum class queue_side { producer, consumer };
+
+    template<class M>
+    concept queue_stats_policy
+        = std::default_initializable<M>
+          && requires { { M::c_enabled } -> std::convertible_to<bool>; }
+          && requires { { M::c_residence } -> std::convertible_to<bool>; }
+          && requires { { M::c_trace } -> std::convertible_to<bool>; }
+          && requires(
+              M m, queue_side side, queue_slot_status status, unsigned probes, int64_t capacity, bool ok,
+              uint64_t ticks, uintptr_t slot, queue_slot_state from, queue_slot_state to
+          ) {
+              m.on_acquire(side, status, probes, capacity);
+              m.on_grow(ok);
+              m.on_lock_contended();
+              m.on_residence(ticks);
+              m.on_transition(slot, from, to);
+          };
+
+    class queue_no_stats {
+    public:
+        static constexpr bool c_enabled [[maybe_unused]] { false };
+        static constexpr bool c_residence [[maybe_unused]] { false };
+        static constexpr bool c_trace [[maybe_unused]] { false };
+
+        void on_acquire(queue_side, queue_slot_status, unsigned, int64_t) noexcept {}
+        void on_grow(bool) noexcept {}
+        void on_lock_contended() noexcept {}
+        void on_residence(uint64_t) noexcept {}
+        void on_transition(uintptr_t, queue_slot_state, queue_slot_state) noexcept {}
+    };
+
+    /** Publication timestamps of N slots, kept only if the residence time is measured (E = true) **/
+    template<bool E, size_t N = 1>
+    class queue_slot_stamps {
+    public:
+        void stamp([[maybe_unused]] size_t index = 0) noexcept {}
+
+        [[nodiscard]]
+        uint64_t elapsed([[maybe_unused]] size_t index = 0) const noexcept {
+            return 0;
+        }
+    };
+
+    template<size_t N>
+    class queue_slot_stamps<true, N> {
+        uint64_t m_stamps[N] {};
+
+    public:
+        void stamp(const size_t index = 0) noexcept {
+            m_stamps[index] = tsc_now();
+        }
+
+        [[nodiscard]]
+        uint64_t elapsed(const size_t index = 0) const noexcept {
+            return tsc_now() - m_stamps[index];
+        }
+    };
 
     class auto_completion {
     public:
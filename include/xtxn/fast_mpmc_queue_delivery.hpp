@@ -0,0 +1,119 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Delivery limit of the fast queues. With R > 0 every slot counts how many times its item has been handed to a
+ * consumer. A consumer that releases the item without completing it after the R-th delivery diverts the item to the
+ * dead-letter sink instead of returning it to the queue, so a poison item can't keep a consumer pool busy forever.
+ * The sink gets the payload by reference and moves it out at most once; if it refuses the item (e.g. its target queue
+ * is full) the item is returned to the queue as before and diverted on its next rejection. Without a sink an item
+ * over the limit is discarded.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <utility>
+
+namespace xtxn {
+    constexpr unsigned queue_unlimited_deliveries [[maybe_unused]] { 0 };
+
+    /** Delivery counters of N slots, kept only with a delivery limit (E = true) **/
+    template<bool E, size_t N = 1>
+    class queue_slot_deliveries {
+    public:
+        void deliver([[maybe_unused]] size_t index = 0) noexcept {}
+        void reset([[maybe_unused]] size_t index = 0) noexcept {}
+
+        [[nodiscard]]
+        uint32_t count([[maybe_unused]] size_t index = 0) const noexcept {
+            return 0;
+        }
+    };
+
+    template<size_t N>
+    class queue_slot_deliveries<true, N> {
+        uint32_t m_counts[N] {};
+
+    public:
+        void deliver(const size_t index = 0) noexcept {
+            ++m_counts[index];
+        }
+
+        void reset(const size_t index = 0) noexcept {
+            m_counts[index] = 0;
+        }
+
+        [[nodiscard]]
+        uint32_t count(const size_t index = 0) const noexcept {
+            return m_counts[index];
+        }
+    };
+
+    /** Dead-letter sink of a queue with the delivery limit R, empty without a limit **/
+    template<typename T, unsigned R>
+    class queue_dead_letter {
+    public:
+        bool divert(T &, uint32_t) noexcept {
+            return false;
+        }
+    };
+
+    template<typename T, unsigned R>
+    requires (R > 0)
+    class queue_dead_letter<T, R> {
+        std::function<bool(T &)> m_sink {};
+        std::atomic_uint64_t m_diverted { 0 };
+
+    public:
+        queue_dead_letter() noexcept = default;
+        queue_dead_letter(const queue_dead_letter &) = delete;
+        queue_dead_letter(queue_dead_letter &&) = delete;
+        ~queue_dead_letter() noexcept = default;
+
+        queue_dead_letter & operator=(const queue_dead_letter &) = delete;
+        queue_dead_letter & operator=(queue_dead_letter &&) = delete;
+
+        void sink(std::function<bool(T &)> sink) noexcept {
+            m_sink = std::move(sink);
+        }
+
+        /** Whether a rejected item with the given number of deliveries has left the queue **/
+        bool divert(T & item, const uint32_t deliveries) noexcept {
+            if (deliveries < R) {
+                return false;
+            }
+            try {
+                if (m_sink && !m_sink(item)) {
+                    return false;
+                }
+            } catch (...) {
+                return false;
+            }
+            m_diverted.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        [[nodiscard]]
+        uint64_t diverted() const noexcept {
+            return m_diverted.load(std::memory_order_relaxed);
+        }
+    };
+
+    /** A sink that moves dead letters to another queue, refusing them while that queue has no free slot **/
+    template<class Q>
+    [[nodiscard, maybe_unused]]
+    auto queue_dead_letter_sink(Q & target, const unsigned attempts = 1) {
+        return [& target, attempts] (typename Q::payload_type & item) {
+            auto slot = target.producer_slot(attempts);
+            if (!slot) {
+                return false;
+            }
+            *slot = std::move(item);
+            slot.complete();
+            return true;
+        };
+    }
+}
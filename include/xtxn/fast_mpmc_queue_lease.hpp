@@ -0,0 +1,206 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Slot locks of the fast queues. With queue_lease_policy::none a slot lock is the bare atomic slot state. With
+ * queue_lease_policy::timeout a lock is a lease: the state word also carries a generation, incremented by every lock,
+ * and the deadline of the lease (in units of 2^10 TSC ticks, 40 bits, so leases must be shorter than about a day).
+ * The accessor keeps the word it has locked as a ticket and unlocks with a CAS from it, so a holder whose lease has
+ * expired and been reclaimed by a sweep can no longer change the slot state. A release pins the lease before any of its
+ * effects (timestamp, delivery count, dead-letter diversion, trace record), so a stale holder releases nothing. The
+ * payload isn't protected: a holder whose lease has been reclaimed may still be reading or writing it while the slot
+ * is used by another thread, so leases are allowed only for trivially copyable payloads (queue_leasable_payload),
+ * which a stale access may garble but can't corrupt.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <type_traits>
+#include "fast_mpmc_queue_commons.hpp"
+#include "latency_histogram.hpp"
+
+namespace xtxn {
+    enum class queue_lease_policy { none, timeout };
+
+    constexpr std::chrono::milliseconds queue_default_lease [[maybe_unused]] { 1'000 };
+
+    template<typename T, queue_lease_policy E>
+    concept queue_leasable_payload = E == queue_lease_policy::none || std::is_trivially_copyable_v<T>;
+
+    /** Lease duration and the counter of reclaimed leases of a queue, empty without leases **/
+    template<queue_lease_policy E>
+    class queue_lease {};
+
+    template<>
+    class queue_lease<queue_lease_policy::timeout> {
+        using mo = std::memory_order;
+
+        static constexpr unsigned c_shift { 10 };
+        static constexpr uint64_t c_mask { (uint64_t { 1 } << 40) - 1 };
+
+        std::atomic_uint64_t m_units { 1 };
+        std::atomic_uint64_t m_reclaimed { 0 };
+
+    public:
+        queue_lease() noexcept {
+            duration(queue_default_lease);
+        }
+
+        queue_lease(const queue_lease &) = delete;
+        queue_lease(queue_lease &&) = delete;
+        ~queue_lease() noexcept = default;
+
+        queue_lease & operator=(const queue_lease &) = delete;
+        queue_lease & operator=(queue_lease &&) = delete;
+
+        void duration(const std::chrono::nanoseconds lease) noexcept {
+            const auto ticks = static_cast<double>(std::max<int64_t>(lease.count(), 0)) * tsc_ticks_per_ns();
+            const auto units = std::clamp<uint64_t>(static_cast<uint64_t>(ticks) >> c_shift, 1, c_mask >> 1);
+            m_units.store(units, mo::relaxed);
+        }
+
+        /** Never 0, which marks a pinned lease **/
+        [[nodiscard]]
+        uint64_t deadline() const noexcept {
+            return std::max<uint64_t>((now() + m_units.load(mo::relaxed)) & c_mask, 1);
+        }
+
+        [[nodiscard]]
+        static uint64_t now() noexcept {
+            return (tsc_now() >> c_shift) & c_mask;
+        }
+
+        [[nodiscard]]
+        static bool expired(const uint64_t deadline, const uint64_t now) noexcept {
+            return ((now - deadline) & c_mask) <= (c_mask >> 1);
+        }
+
+        void count_reclaimed() noexcept {
+            m_reclaimed.fetch_add(1, mo::relaxed);
+        }
+
+        [[nodiscard]]
+        uint64_t reclaimed() const noexcept {
+            return m_reclaimed.load(mo::relaxed);
+        }
+    };
+
+    template<queue_lease_policy E>
+    class queue_slot_lock {
+        using mo = std::memory_order;
+
+        std::atomic<queue_slot_state> m_state { queue_slot_state::free };
+
+    public:
+        struct ticket {};
+
+        [[nodiscard]]
+        queue_slot_state load(const mo order = mo::acquire) const noexcept {
+            return m_state.load(order);
+        }
+
+        bool lock(queue_slot_state from, const queue_slot_state to, ticket &, const queue_lease<E> &) noexcept {
+            return m_state.compare_exchange_strong(from, to, mo::acq_rel, mo::acquire);
+        }
+
+        bool pin(ticket &) noexcept {
+            return true;
+        }
+
+        bool unlock(const ticket &, const queue_slot_state to) noexcept {
+            m_state.store(to, mo::release);
+            return true;
+        }
+    };
+
+    template<>
+    class queue_slot_lock<queue_lease_policy::timeout> {
+        using mo = std::memory_order;
+        using lease = queue_lease<queue_lease_policy::timeout>;
+
+        static constexpr unsigned c_generation_shift { 2 };
+        static constexpr unsigned c_deadline_shift { 24 };
+        static constexpr uint64_t c_state_mask { 0x3 };
+        static constexpr uint64_t c_generation_mask { ((uint64_t { 1 } << c_deadline_shift) - 1) & ~c_state_mask };
+
+        std::atomic_uint64_t m_word { static_cast<uint64_t>(queue_slot_state::free) };
+
+        static queue_slot_state state(const uint64_t word) noexcept {
+            return static_cast<queue_slot_state>(word & c_state_mask);
+        }
+
+        static uint64_t pack(const uint64_t word, const queue_slot_state to, const uint64_t deadline) noexcept {
+            return (deadline << c_deadline_shift) | (word & c_generation_mask) | static_cast<uint64_t>(to);
+        }
+
+    public:
+        using ticket = uint64_t;
+
+        [[nodiscard]]
+        queue_slot_state load(const mo order = mo::acquire) const noexcept {
+            return state(m_word.load(order));
+        }
+
+        bool lock(const queue_slot_state from, const queue_slot_state to, ticket & held, const lease & lease) noexcept {
+            auto word = m_word.load(mo::acquire);
+            if (state(word) != from) {
+                return false;
+            }
+            held = pack(word + (uint64_t { 1 } << c_generation_shift), to, lease.deadline());
+            return m_word.compare_exchange_strong(word, held, mo::acq_rel, mo::acquire);
+        }
+
+        /**
+         * Makes the lease permanent (a pinned lease has the deadline 0 and is never reclaimed), so the following unlock
+         * can't fail; fails if the lease has been reclaimed in the meantime.
+         */
+        bool pin(ticket & held) noexcept {
+            auto expected = held;
+            const auto pinned = pack(held, state(held), 0);
+            if (!m_word.compare_exchange_strong(expected, pinned, mo::acq_rel, mo::relaxed)) {
+                return false;
+            }
+            held = pinned;
+            return true;
+        }
+
+        /** Fails if the lease has been reclaimed in the meantime **/
+        bool unlock(const ticket & held, const queue_slot_state to) noexcept {
+            auto expected = held;
+            return m_word.compare_exchange_strong(expected, pack(held, to, 0), mo::acq_rel, mo::relaxed);
+        }
+
+        /** Extends the lease from now on, fails if it has been reclaimed **/
+        bool renew(ticket & held, const lease & lease) noexcept {
+            auto expected = held;
+            const auto renewed = pack(held, state(held), lease.deadline());
+            if (!m_word.compare_exchange_strong(expected, renewed, mo::acq_rel, mo::relaxed)) {
+                return false;
+            }
+            held = renewed;
+            return true;
+        }
+
+        /** Returns the state of an expired lease taken back: prod_locked becomes free, cons_locked becomes ready **/
+        std::optional<queue_slot_state> reclaim(const uint64_t now) noexcept {
+            auto word = m_word.load(mo::acquire);
+            const auto locked = state(word);
+            if (
+                (locked != queue_slot_state::prod_locked && locked != queue_slot_state::cons_locked)
+                || !(word >> c_deadline_shift) || !lease::expired(word >> c_deadline_shift, now)
+            ) {
+                return std::nullopt;
+            }
+            const auto to = locked == queue_slot_state::prod_locked ? queue_slot_state::free : queue_slot_state::ready;
+            if (!m_word.compare_exchange_strong(word, pack(word, to, 0), mo::acq_rel, mo::relaxed)) {
+                return std::nullopt;
+            }
+            return locked;
+        }
+    };
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Single up-front allocation of the slots of a queue sized at run time. On Linux the region is an anonymous mapping:
+ * with huge pages requested it is mapped from the hugetlb pool (2 MiB pages) or, if the pool is empty, advised for
+ * transparent huge pages; with a NUMA node given, the pages are preferably placed on that node (mbind before they are
+ * touched). Elsewhere the region is an aligned heap allocation and both options are ignored.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <new>
+#ifdef __linux__
+#   include <linux/mempolicy.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+namespace xtxn {
+    struct queue_memory_options {
+        bool m_huge_pages { false };
+        int m_numa_node { -1 }; /** -1 - no preference **/
+    };
+
+    class queue_memory_region {
+        static constexpr size_t c_page_size { 0x1'000 };
+        static constexpr size_t c_huge_page_size { 0x20'0000 };
+
+        void * m_data { nullptr };
+        size_t m_size { 0 };
+        bool m_huge_pages { false };
+        bool m_numa_bound { false };
+
+        static size_t round_up(const size_t size, const size_t alignment) noexcept {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+    public:
+        /** Throws std::bad_alloc if the region can't be allocated **/
+        queue_memory_region(const size_t size, const queue_memory_options & options) {
+#ifdef __linux__
+            m_size = round_up(size, options.m_huge_pages ? c_huge_page_size : c_page_size);
+            constexpr int protection { PROT_READ | PROT_WRITE };
+            constexpr int flags { MAP_PRIVATE | MAP_ANONYMOUS };
+            if (options.m_huge_pages) {
+                m_data = ::mmap(nullptr, m_size, protection, flags | MAP_HUGETLB, -1, 0);
+                m_huge_pages = m_data != MAP_FAILED;
+            }
+            if (!m_huge_pages) {
+                m_data = ::mmap(nullptr, m_size, protection, flags, -1, 0);
+                if (m_data == MAP_FAILED) {
+                    m_data = nullptr;
+                    throw std::bad_alloc {};
+                }
+                if (options.m_huge_pages) {
+                    m_huge_pages = !::madvise(m_data, m_size, MADV_HUGEPAGE);
+                }
+            }
+            constexpr size_t bits { sizeof(unsigned long) * CHAR_BIT };
+            if (options.m_numa_node >= 0 && static_cast<size_t>(options.m_numa_node) < bits) {
+                const unsigned long mask { 1ul << options.m_numa_node };
+                m_numa_bound = !::syscall(SYS_mbind, m_data, m_size, MPOL_PREFERRED, &mask, bits + 1, 0);
+            }
+#else
+            static_cast<void>(options);
+            m_size = round_up(size, c_page_size);
+            m_data = ::operator new(m_size, std::align_val_t { c_page_size });
+#endif
+        }
+
+        queue_memory_region(const queue_memory_region &) = delete;
+        queue_memory_region(queue_memory_region &&) = delete;
+
+        ~queue_memory_region() noexcept {
+#ifdef __linux__
+            if (m_data) {
+                ::munmap(m_data, m_size);
+            }
+#else
+            ::operator delete(m_data, m_size, std::align_val_t { c_page_size });
+#endif
+        }
+
+        queue_memory_region & operator=(const queue_memory_region &) = delete;
+        queue_memory_region & operator=(queue_memory_region &&) = delete;
+
+        [[nodiscard]]
+        std::byte * data() const noexcept {
+            return static_cast<std::byte *>(m_data);
+        }
+
+        [[nodiscard, maybe_unused]]
+        size_t size() const noexcept {
+            return m_size;
+        }
+
+        /** Whether the region is backed by huge pages (hugetlb) or advised to be (transparent huge pages) **/
+        [[nodiscard, maybe_unused]]
+        bool huge_pages() const noexcept {
+            return m_huge_pages;
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool numa_bound() const noexcept {
+            return m_numa_bound;
+        }
+    };
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Statistics policy for the fast queues. Counters are kept in K cache-line aligned shards; every thread updates its
+ * own shard, so collecting statistics does not add shared writes to the hot path. The stats() snapshot sums the shards
+ * and is only approximately consistent while the queue is in use.
+ * With R = true the queue also stamps every published slot with the TSC and the consumer records the residence time
+ * (publication to acquisition) into a shared lock-free latency histogram.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <bit>
+#include <algorithm>
+#include <variant>
+#include "types.hpp"
+#include "fast_mpmc_queue_commons.hpp"
+#include "latency_histogram.hpp"
+
+namespace xtxn {
+    constexpr unsigned queue_stats_default_shards [[maybe_unused]] { 0x20 };
+    constexpr unsigned queue_stats_histogram_buckets [[maybe_unused]] { 0x10 };
+
+    struct queue_stats_snapshot {
+        struct side_stats {
+            uint64_t m_acquired { 0 };
+            uint64_t m_full { 0 };
+            uint64_t m_stopped { 0 };
+            uint64_t m_contended { 0 };
+            uint64_t m_empty { 0 };
+            uint64_t m_cas_failures { 0 };
+            uint64_t m_laps { 0 };
+            /** m_probes[i] counts successful acquisitions that took [2^(i-1), 2^i) probes **/
+            uint64_t m_probes[queue_stats_histogram_buckets] {};
+        };
+
+        side_stats m_producer {};
+        side_stats m_consumer {};
+        uint64_t m_grows { 0 };
+        uint64_t m_grow_failures { 0 };
+        uint64_t m_lock_waits { 0 };
+        /** Residence time in nanoseconds, filled only if the policy measures it **/
+        latency_summary m_residence {};
+    };
+
+    template<unsigned K = queue_stats_default_shards, bool R = false>
+    requires (K > 0)
+    class queue_stats {
+        using mo = std::memory_order;
+        using counter = std::atomic_uint64_t;
+
+        struct side_counters {
+            counter m_acquired { 0 };
+            counter m_full { 0 };
+            counter m_stopped { 0 };
+            counter m_contended { 0 };
+            counter m_empty { 0 };
+            counter m_cas_failures { 0 };
+            counter m_laps { 0 };
+            counter m_probes[queue_stats_histogram_buckets] {};
+        };
+
+        struct alignas(false_sharing_align) shard {
+            side_counters m_sides[2] {};
+            counter m_grows { 0 };
+            counter m_grow_failures { 0 };
+            counter m_lock_waits { 0 };
+        };
+
+        shard m_shards[K] {};
+        [[no_unique_address]] std::conditional_t<R, latency_histogram<>, std::monostate> m_residence {};
+
+        static void bump(counter & value, const uint64_t delta = 1) noexcept {
+            value.fetch_add(delta, mo::relaxed);
+        }
+
+        shard & local() noexcept {
+            static std::atomic_uint s_next_shard { 0 };
+            thread_local const unsigned index { s_next_shard.fetch_add(1, mo::relaxed) % K };
+            return m_shards[index];
+        }
+
+        static void collect(queue_stats_snapshot::side_stats & result, const side_counters & source) noexcept {
+            result.m_acquired += source.m_acquired.load(mo::relaxed);
+            result.m_full += source.m_full.load(mo::relaxed);
+            result.m_stopped += source.m_stopped.load(mo::relaxed);
+            result.m_contended += source.m_contended.load(mo::relaxed);
+            result.m_empty += source.m_empty.load(mo::relaxed);
+            result.m_cas_failures += source.m_cas_failures.load(mo::relaxed);
+            result.m_laps += source.m_laps.load(mo::relaxed);
+            for (unsigned i { 0 }; i < queue_stats_histogram_buckets; ++i) {
+                result.m_probes[i] += source.m_probes[i].load(mo::relaxed);
+            }
+        }
+
+    public:
+        static constexpr bool c_enabled [[maybe_unused]] { true };
+        static constexpr bool c_residence [[maybe_unused]] { R };
+        static constexpr bool c_trace [[maybe_unused]] { false };
+
+        queue_stats() noexcept = default;
+        queue_stats(const queue_stats &) = delete;
+        queue_stats(queue_stats &&) = delete;
+        ~queue_stats() noexcept = default;
+
+        queue_stats & operator=(const queue_stats &) = delete;
+        queue_stats & operator=(queue_stats &&) = delete;
+
+        void on_acquire(
+            const queue_side side,
+            const queue_slot_status status,
+            const unsigned probes,
+            const int64_t capacity
+        ) noexcept {
+            auto & counters = local().m_sides[side == queue_side::producer ? 0 : 1];
+            switch (status) {
+                case queue_slot_status::acquired: {
+                    const auto bucket = std::min<unsigned>(
+                        static_cast<unsigned>(std::bit_width(probes)),
+                        queue_stats_histogram_buckets - 1
+                    );
+                    bump(counters.m_acquired);
+                    bump(counters.m_probes[bucket]);
+                    if (probes > 1) {
+                        bump(counters.m_cas_failures, probes - 1);
+                    }
+                    break;
+                }
+                case queue_slot_status::full:
+                    bump(counters.m_full);
+                    break;
+                case queue_slot_status::stopped:
+                    bump(counters.m_stopped);
+                    break;
+                case queue_slot_status::contended:
+                    bump(counters.m_contended);
+                    break;
+                case queue_slot_status::empty:
+                    bump(counters.m_empty);
+                    break;
+            }
+            if (status != queue_slot_status::acquired && probes) {
+                bump(counters.m_cas_failures, probes);
+            }
+            if (capacity > 0 && probes >= static_cast<uint64_t>(capacity)) {
+                bump(counters.m_laps, probes / static_cast<uint64_t>(capacity));
+            }
+        }
+
+        void on_grow(const bool ok) noexcept {
+            bump(ok ? local().m_grows : local().m_grow_failures);
+        }
+
+        void on_lock_contended() noexcept {
+            bump(local().m_lock_waits);
+        }
+
+        void on_residence([[maybe_unused]] const uint64_t ticks) noexcept {
+            if constexpr (R) {
+                m_residence.record(ticks);
+            }
+        }
+
+        void on_transition(uintptr_t, queue_slot_state, queue_slot_state) noexcept {}
+
+        [[nodiscard]]
+        queue_stats_snapshot snapshot() const noexcept {
+            queue_stats_snapshot result {};
+            for (auto & shard : m_shards) {
+                collect(result.m_producer, shard.m_sides[0]);
+                collect(result.m_consumer, shard.m_sides[1]);
+                result.m_grows += shard.m_grows.load(mo::relaxed);
+                result.m_grow_failures += shard.m_grow_failures.load(mo::relaxed);
+                result.m_lock_waits += shard.m_lock_waits.load(mo::relaxed);
+            }
+            if constexpr (R) {
+                result.m_residence = m_residence.summary(1.0 / tsc_ticks_per_ns());
+            }
+            return result;
+        }
+    };
+}
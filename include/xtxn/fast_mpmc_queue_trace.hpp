@@ -0,0 +1,126 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Slot state trace policy for the fast queues. Every successful slot state transition is recorded with the TSC, the
+ * slot (index in the static queue, address in the dynamic one), the old and the new state and the number of the thread.
+ * Records go to K fixed-size rings of N records; a thread always writes to the same ring, so with up to K threads every
+ * ring has a single writer. The rings keep the latest N transitions of their threads and are dumped in a binary format
+ * (queue_trace_header followed by queue_trace_record entries) that src/trace_report_main.cpp reads. A dump taken while
+ * the queue is in use may contain a few torn records. The statistics of the wrapped policy M are kept as well.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "types.hpp"
+#include "fast_mpmc_queue_commons.hpp"
+#include "latency_histogram.hpp"
+
+namespace xtxn {
+    constexpr unsigned queue_trace_default_records [[maybe_unused]] { 0x1'000 };
+    constexpr unsigned queue_trace_default_rings [[maybe_unused]] { 0x20 };
+
+    struct queue_trace_record {
+        uint64_t m_tsc { 0 };
+        uint64_t m_slot { 0 };
+        uint32_t m_thread { 0 };
+        uint8_t m_from { 0 }; /** queue_slot_state **/
+        uint8_t m_to { 0 }; /** queue_slot_state **/
+        uint16_t m_reserved { 0 };
+    };
+
+    struct queue_trace_header {
+        char m_magic[8] { 'X', 'T', 'X', 'N', 'T', 'R', 'C', '1' };
+        uint32_t m_record_size { sizeof(queue_trace_record) };
+        uint32_t m_rings { 0 };
+        uint32_t m_ring_records { 0 };
+        uint32_t m_reserved { 0 };
+        double m_ticks_per_ns { 0.0 };
+        uint64_t m_records { 0 };
+    };
+
+    template<
+        queue_stats_policy M = queue_no_stats,
+        unsigned N = queue_trace_default_records,
+        unsigned K = queue_trace_default_rings
+    >
+    requires (std::has_single_bit(N)) && (K > 0)
+    class queue_trace : public M {
+        using mo = std::memory_order;
+
+        struct alignas(false_sharing_align) ring {
+            std::atomic_uint64_t m_next { 0 };
+            queue_trace_record m_records[N] {};
+        };
+
+        std::unique_ptr<ring[]> m_rings { std::make_unique<ring[]>(K) };
+
+        static uint32_t thread_number() noexcept {
+            static std::atomic_uint32_t s_next_thread { 0 };
+            thread_local const uint32_t number { s_next_thread.fetch_add(1, mo::relaxed) };
+            return number;
+        }
+
+    public:
+        static constexpr bool c_trace [[maybe_unused]] { true };
+        static constexpr unsigned c_trace_records [[maybe_unused]] { N };
+        static constexpr unsigned c_trace_rings [[maybe_unused]] { K };
+
+        queue_trace() = default;
+        queue_trace(const queue_trace &) = delete;
+        queue_trace(queue_trace &&) = delete;
+        ~queue_trace() noexcept = default;
+
+        queue_trace & operator=(const queue_trace &) = delete;
+        queue_trace & operator=(queue_trace &&) = delete;
+
+        void on_transition(const uintptr_t slot, const queue_slot_state from, const queue_slot_state to) noexcept {
+            const auto thread = thread_number();
+            auto & target = m_rings[thread % K];
+            target.m_records[target.m_next.fetch_add(1, mo::relaxed) & (N - 1)] = {
+                tsc_now(), slot, thread, static_cast<uint8_t>(from), static_cast<uint8_t>(to), 0
+            };
+        }
+
+        /** The recorded transitions ordered by time **/
+        [[nodiscard]]
+        std::vector<queue_trace_record> records() const {
+            std::vector<queue_trace_record> result {};
+            for (unsigned i { 0 }; i < K; ++i) {
+                const auto next = m_rings[i].m_next.load(mo::acquire);
+                for (auto position = next > N ? next - N : 0; position < next; ++position) {
+                    result.push_back(m_rings[i].m_records[position & (N - 1)]);
+                }
+            }
+            std::ranges::stable_sort(result, {}, &queue_trace_record::m_tsc);
+            return result;
+        }
+
+        bool dump(std::ostream & stream) const {
+            const auto entries = records();
+            const queue_trace_header header {
+                .m_rings = K, .m_ring_records = N, .m_ticks_per_ns = tsc_ticks_per_ns(), .m_records = entries.size()
+            };
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            stream.write(
+                reinterpret_cast<const char *>(entries.data()),
+                static_cast<std::streamsize>(entries.size() * sizeof(queue_trace_record))
+            );
+            return static_cast<bool>(stream);
+        }
+
+        bool dump(const std::string & path) const {
+            std::ofstream file { path, std::ios::binary };
+            return file && dump(file);
+        }
+    };
+}
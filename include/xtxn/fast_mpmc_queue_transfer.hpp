@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Payload transfer of the fast queues. With queue_transfer_policy::streaming a producer can store a trivially copyable
+ * payload with non-temporal stores, which bypass its cache since only a consumer will read the payload, and a consumer
+ * that has acquired a slot prefetches the payload of the next slot, the one most likely to be ready next. Non-temporal
+ * stores are weakly ordered, so a store ends with a store fence before the slot can be published. Without SSE2 the
+ * stores are plain copies.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include "types.hpp"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define XTXN_STREAMING_STORES
+#endif
+
+namespace xtxn {
+    enum class queue_transfer_policy { plain, streaming };
+
+    template<queue_transfer_policy X>
+    class queue_transfer {
+    public:
+        template<typename T>
+        static void prefetch(const T &) noexcept {}
+    };
+
+    template<>
+    class queue_transfer<queue_transfer_policy::streaming> {
+        static constexpr size_t c_line { true_sharing_align };
+        static constexpr size_t c_max_prefetch_lines { 0x40 };
+
+    public:
+        template<typename T>
+        requires std::is_trivially_copyable_v<T>
+        static void store(T & target, const T & source) noexcept {
+#ifdef XTXN_STREAMING_STORES
+            constexpr uintptr_t vector { sizeof(__m128i) };
+            auto to = reinterpret_cast<uintptr_t>(&target);
+            auto from = reinterpret_cast<uintptr_t>(&source);
+            const auto end = to + sizeof(T);
+            if (const auto head = std::min<uintptr_t>((vector - (to & (vector - 1))) & (vector - 1), sizeof(T)); head) {
+                std::memcpy(reinterpret_cast<void *>(to), reinterpret_cast<const void *>(from), head);
+                to += head;
+                from += head;
+            }
+            for (; end - to >= vector; to += vector, from += vector) {
+                _mm_stream_si128(
+                    reinterpret_cast<__m128i *>(to), _mm_loadu_si128(reinterpret_cast<const __m128i *>(from))
+                );
+            }
+            if (to < end) {
+                std::memcpy(reinterpret_cast<void *>(to), reinterpret_cast<const void *>(from), end - to);
+            }
+            _mm_sfence();
+#else
+            std::memcpy(&target, &source, sizeof(T));
+#endif
+        }
+
+        template<typename T>
+        static void prefetch(const T & payload) noexcept {
+            constexpr size_t lines { std::min((sizeof(T) + c_line - 1) / c_line, c_max_prefetch_lines) };
+            const auto * const from = reinterpret_cast<const char *>(&payload);
+            for (size_t line { 0 }; line < lines; ++line) {
+#if defined(XTXN_STREAMING_STORES)
+                _mm_prefetch(from + line * c_line, _MM_HINT_T0);
+#elif defined(__GNUC__)
+                __builtin_prefetch(from + line * c_line, 0, 3);
+#else
+                static_cast<void>(from);
+#endif
+            }
+        }
+    };
+}
@@ -0,0 +1,207 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Log-linear (HDR-style) latency histogram. Values below 2^B are counted exactly, every following power of two is
+ * split into 2^B equal sub-buckets, so the relative error of a reported value does not exceed 2^-B. With the atomic
+ * counters (the default) the histogram may be updated concurrently without locks; the non-atomic variant is meant for
+ * thread-local collection followed by merge().
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <type_traits>
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h> // NOLINT
+#else
+#   include <x86intrin.h> // NOLINT
+#endif
+
+namespace xtxn {
+    constexpr unsigned latency_histogram_default_precision [[maybe_unused]] { 5 };
+
+    [[nodiscard, maybe_unused]]
+    inline uint64_t tsc_now() noexcept {
+        return __rdtsc();
+    }
+
+    /** TSC ticks per nanosecond, calibrated against steady_clock on the first call (takes about 10 ms) **/
+    [[nodiscard, maybe_unused]]
+    inline double tsc_ticks_per_ns() noexcept {
+        static const double s_ratio {
+            [] {
+                using clock = std::chrono::steady_clock;
+                const auto t1 = clock::now();
+                const auto c1 = tsc_now();
+                while (clock::now() - t1 < std::chrono::milliseconds { 10 }) {}
+                const auto c2 = tsc_now();
+                const auto t2 = clock::now();
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+                return static_cast<double>(c2 - c1) / static_cast<double>(ns);
+            } ()
+        };
+        return s_ratio;
+    }
+
+    struct latency_summary {
+        uint64_t m_count { 0 };
+        uint64_t m_p50 { 0 };
+        uint64_t m_p99 { 0 };
+        uint64_t m_p999 { 0 };
+        uint64_t m_max { 0 };
+    };
+
+    template<unsigned B = latency_histogram_default_precision, bool A = true>
+    requires (B > 0) && (B < 16)
+    class latency_histogram {
+        using mo = std::memory_order;
+        using counter = std::conditional_t<A, std::atomic_uint64_t, uint64_t>;
+
+        static constexpr uint64_t c_sub_buckets { uint64_t { 1 } << B };
+        static constexpr unsigned c_buckets { (65 - B) << B };
+
+        counter m_counts[c_buckets] {};
+        counter m_total { 0 };
+        counter m_max { 0 };
+
+        static uint64_t load(const counter & value) noexcept {
+            if constexpr (A) {
+                return value.load(mo::relaxed);
+            } else {
+                return value;
+            }
+        }
+
+        static void add(counter & value, const uint64_t delta) noexcept {
+            if constexpr (A) {
+                value.fetch_add(delta, mo::relaxed);
+            } else {
+                value += delta;
+            }
+        }
+
+        static void raise(counter & value, const uint64_t candidate) noexcept {
+            if constexpr (A) {
+                auto current = value.load(mo::relaxed);
+                while (current < candidate && !value.compare_exchange_weak(current, candidate, mo::relaxed)) {}
+            } else if (value < candidate) {
+                value = candidate;
+            }
+        }
+
+        static unsigned bucket(const uint64_t value) noexcept {
+            if (value < c_sub_buckets) {
+                return static_cast<unsigned>(value);
+            }
+            const auto shift = static_cast<unsigned>(std::bit_width(value)) - 1 - B;
+            return ((shift + 1) << B) + static_cast<unsigned>((value >> shift) - c_sub_buckets);
+        }
+
+        static uint64_t upper_bound(const unsigned index) noexcept {
+            const unsigned group { index >> B };
+            if (!group) {
+                return index;
+            }
+            const unsigned shift { group - 1 };
+            const auto lower = ((index & (c_sub_buckets - 1)) + c_sub_buckets) << shift;
+            return lower + ((uint64_t { 1 } << shift) - 1);
+        }
+
+    public:
+        static constexpr unsigned c_precision [[maybe_unused]] { B };
+        static constexpr bool c_atomic [[maybe_unused]] { A };
+
+        latency_histogram() noexcept = default;
+        latency_histogram(const latency_histogram &) = delete;
+        latency_histogram(latency_histogram &&) = delete;
+        ~latency_histogram() noexcept = default;
+
+        latency_histogram & operator=(const latency_histogram &) = delete;
+        latency_histogram & operator=(latency_histogram &&) = delete;
+
+        void record(const uint64_t value) noexcept {
+            add(m_counts[bucket(value)], 1);
+            add(m_total, 1);
+            raise(m_max, value);
+        }
+
+        template<unsigned U, bool V>
+        void merge(const latency_histogram<U, V> & other) noexcept requires (U == B) {
+            for (unsigned i { 0 }; i < c_buckets; ++i) {
+                if (const auto count = other.count_at(i); count) {
+                    add(m_counts[i], count);
+                }
+            }
+            add(m_total, other.count());
+            raise(m_max, other.max());
+        }
+
+        void reset() noexcept requires (!A) {
+            for (auto & count : m_counts) {
+                count = 0;
+            }
+            m_total = 0;
+            m_max = 0;
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t count() const noexcept {
+            return load(m_total);
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t count_at(const unsigned index) const noexcept {
+            return load(m_counts[index]);
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t max() const noexcept {
+            return load(m_max);
+        }
+
+        /** The smallest recorded value (up to the bucket precision) not exceeded by the q-th fraction of values **/
+        [[nodiscard, maybe_unused]]
+        uint64_t percentile(const double q) const noexcept {
+            uint64_t total { 0 };
+            for (auto & count : m_counts) {
+                total += load(count);
+            }
+            if (!total) {
+                return 0;
+            }
+            const auto rank = std::max<uint64_t>(
+                static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))),
+                1
+            );
+            uint64_t seen { 0 };
+            for (unsigned i { 0 }; i < c_buckets; ++i) {
+                seen += load(m_counts[i]);
+                if (seen >= rank) {
+                    return std::min(upper_bound(i), max());
+                }
+            }
+            return max();
+        }
+
+        /** Summary with every value multiplied by the scale, e.g. 1.0 / tsc_ticks_per_ns() to report nanoseconds **/
+        [[nodiscard, maybe_unused]]
+        latency_summary summary(const double scale = 1.0) const noexcept {
+            const auto scaled = [scale] (const uint64_t value) {
+                return static_cast<uint64_t>(static_cast<double>(value) * scale);
+            };
+            return {
+                count(),
+                scaled(percentile(0.5)),
+                scaled(percentile(0.99)),
+                scaled(percentile(0.999)),
+                scaled(max())
+            };
+        }
+    };
+}
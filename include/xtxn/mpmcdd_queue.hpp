@@ -3,16 +3,34 @@
 
 /**
  * Implementation of an MPMC Queue with deferred deletion.
+ * With an automatic purge policy the dequeuing thread opportunistically purges the deleted nodes once the threshold
+ * N is reached: after N dequeues (policy 'deletions') or while the deleted list holds at least N nodes
+ * (policy 'length').
+ * One dequeuing thread at a time attempts the purge without waiting for the barrier. If any other thread is inside the
+ * queue, the attempt is skipped and retried after another N/4 dequeues; after c_purge_attempts skipped attempts in a
+ * row the purge waits for the barrier, so the deleted list stays bounded under a steady load.
+ * The barrier prefers purgers, so a manual purge() is not starved by the enqueuing and dequeuing threads.
  */
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include "types.hpp"
 #include "color_barrier.hpp"
 
 namespace xtxn {
-    template<typename T>
+    enum class queue_purge_policy { manual, deletions, length };
+
+    constexpr int64_t queue_default_purge_threshold [[maybe_unused]] { 0x400 };
+
+    template<
+        typename T,
+        queue_purge_policy P = queue_purge_policy::manual,
+        int64_t N = queue_default_purge_threshold
+    >
+    requires (N > 0)
     class alignas(true_sharing_align) mpmcdd_queue final {
         struct node;
         using mo = std::memory_order;
@@ -20,11 +38,24 @@ namespace xtxn {
         std::atomic<node *> m_head;
         std::atomic<node *> m_tail;
         std::atomic<node *> m_deleted { nullptr };
-        color_barrier m_barrier {};
+        basic_color_barrier<color_preference::red> m_barrier {};
+        alignas(false_sharing_align) std::atomic_int_fast64_t m_purge_counter { N };
+        alignas(false_sharing_align) std::atomic_flag m_purging {};
+        unsigned m_purge_failures { 0 };
         alignas(false_sharing_align) std::atomic_flag m_producing {};
         alignas(false_sharing_align) std::atomic_flag m_consuming {};
 
+        static constexpr int64_t c_purge_retry { N / 4 ? N / 4 : 1 };
+        static constexpr unsigned c_purge_attempts { 4 };
+
+        std::unique_ptr<T> dequeue_data();
+        void auto_purge();
+        void purge_deleted();
+
     public:
+        static constexpr queue_purge_policy c_purge_policy [[maybe_unused]] { P };
+        static constexpr int64_t c_purge_threshold [[maybe_unused]] { N };
+
         mpmcdd_queue();
         mpmcdd_queue(const mpmcdd_queue &) = delete;
         mpmcdd_queue(mpmcdd_queue && other) = delete;
@@ -52,6 +83,7 @@ namespace xtxn {
         template <typename U> bool enqueue(U &&);
         [[nodiscard]] std::unique_ptr<T> dequeue();
         [[maybe_unused]] void purge();
+        [[maybe_unused]] bool try_purge();
 
         [[maybe_unused]]
         void shutdown() noexcept {
@@ -65,8 +97,9 @@ namespace xtxn {
         }
     };
 
-    template<typename T>
-    struct mpmcdd_queue<T>::node final {
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
+    struct mpmcdd_queue<T, P, N>::node final {
         std::unique_ptr<T> m_data;
         std::atomic<node *> m_next { nullptr };
         std::atomic<node *> m_next_deleted { nullptr };
@@ -86,14 +119,16 @@ namespace xtxn {
         node & operator=(node && other) = delete;
     };
 
-    template<typename T>
-    mpmcdd_queue<T>::mpmcdd_queue() : m_head { new node }, m_tail { m_head.load(mo::relaxed) } {
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
+    mpmcdd_queue<T, P, N>::mpmcdd_queue() : m_head { new node }, m_tail { m_head.load(mo::relaxed) } {
         m_producing.test_and_set(mo::acquire);
         m_consuming.test_and_set(mo::acquire);
     }
 
-    template<typename T>
-    mpmcdd_queue<T>::~mpmcdd_queue() {
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
+    mpmcdd_queue<T, P, N>::~mpmcdd_queue() {
         stop();
 
         red_lock lock { m_barrier };
@@ -117,9 +152,10 @@ namespace xtxn {
         }
     }
 
-    template<typename T>
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
     template<typename U>
-    bool mpmcdd_queue<T>::enqueue(U && value) {
+    bool mpmcdd_queue<T, P, N>::enqueue(U && value) {
         if (!m_producing.test(mo::acquire)) {
             return false;
         }
@@ -144,9 +180,55 @@ namespace xtxn {
         return true;
     }
 
-    template<typename T>
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
     [[nodiscard]]
-    std::unique_ptr<T> mpmcdd_queue<T>::dequeue() {
+    std::unique_ptr<T> mpmcdd_queue<T, P, N>::dequeue() {
+        std::unique_ptr<T> result { dequeue_data() };
+
+        if constexpr (P == queue_purge_policy::deletions) {
+            if (result && m_purge_counter.fetch_sub(1, mo::acq_rel) <= 1) {
+                auto_purge();
+            }
+        } else if constexpr (P == queue_purge_policy::length) {
+            if (result && m_purge_counter.load(mo::acquire) <= 0) {
+                auto_purge();
+            }
+        }
+
+        return result;
+    }
+
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
+    void mpmcdd_queue<T, P, N>::auto_purge() {
+        if (m_purging.test_and_set(mo::acquire)) {
+            return;
+        }
+
+        bool purged { try_purge() };
+        if (!purged && ++m_purge_failures >= c_purge_attempts) {
+            purge();
+            purged = true;
+        }
+
+        if (purged) {
+            m_purge_failures = 0;
+            if constexpr (P == queue_purge_policy::deletions) {
+                m_purge_counter.store(N, mo::release);
+            }
+        } else if constexpr (P == queue_purge_policy::deletions) {
+            m_purge_counter.store(c_purge_retry, mo::release);
+        } else {
+            m_purge_counter.fetch_add(c_purge_retry, mo::acq_rel);
+        }
+
+        m_purging.clear(mo::release);
+    }
+
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
+    std::unique_ptr<T> mpmcdd_queue<T, P, N>::dequeue_data() {
         green_lock lock { m_barrier };
 
         while (m_consuming.test(mo::acquire)) {
@@ -170,6 +252,9 @@ namespace xtxn {
                 if (m_head.compare_exchange_strong(head, first, mo::acq_rel, mo::acquire)) {
                     auto result = std::move(first->m_data);
                     head->m_next_deleted.store(m_deleted.exchange(head, mo::acq_rel), mo::release);
+                    if constexpr (P == queue_purge_policy::length) {
+                        m_purge_counter.fetch_sub(1, mo::acq_rel);
+                    }
                     return result;
                 }
             }
@@ -178,13 +263,34 @@ namespace xtxn {
         return { nullptr };
     }
 
-    template<typename T>
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
     [[maybe_unused]]
-    void mpmcdd_queue<T>::purge() {
+    void mpmcdd_queue<T, P, N>::purge() {
         red_lock lock { m_barrier };
+        purge_deleted();
+    }
 
-        node * current { m_deleted.load(mo::relaxed) };
-        while (current && m_consuming.test(mo::acquire)) {
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
+    [[maybe_unused]]
+    bool mpmcdd_queue<T, P, N>::try_purge() {
+        red_lock lock { m_barrier, std::try_to_lock };
+        if (!lock) {
+            return false;
+        }
+        purge_deleted();
+        return true;
+    }
+
+    template<typename T, queue_purge_policy P, int64_t N>
+    requires (N > 0)
+    void mpmcdd_queue<T, P, N>::purge_deleted() {
+        node * current { m_deleted.exchange(nullptr, mo::acq_rel) };
+        if constexpr (P == queue_purge_policy::length) {
+            m_purge_counter.store(N, mo::release);
+        }
+        while (current) {
             node * next { current->m_next_deleted.load(mo::relaxed) };
             delete current;
             current = next;
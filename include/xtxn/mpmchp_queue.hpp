@@ -0,0 +1,348 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Implementation of an MPMC Queue with hazard pointer reclamation.
+ * Every thread owns a hazard record with two hazard pointers and a private list of retired nodes. The list is scanned
+ * once it grows to R nodes, so the number of unreclaimed nodes stays bounded even if some threads are descheduled.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "types.hpp"
+
+namespace xtxn {
+    constexpr int queue_default_hp_scan_threshold { 0x40 };
+
+    template<typename T, int R = queue_default_hp_scan_threshold>
+    requires (R >= 2)
+    class alignas(true_sharing_align) mpmchp_queue final {
+        struct node;
+        struct hazard_record;
+        using mo = std::memory_order;
+        using id_type = uint_fast64_t;
+
+        struct record_cache {
+            id_type m_queue_id { 0 };
+            hazard_record * m_record { nullptr };
+        };
+
+        static constexpr size_t c_hazards { 2 };
+
+        inline static std::atomic<id_type> s_last_id { 0 };
+
+        std::atomic<node *> m_head;
+        std::atomic<node *> m_tail;
+        std::atomic<hazard_record *> m_records { nullptr };
+        const id_type m_id { s_last_id.fetch_add(1, mo::relaxed) + 1 };
+        alignas(false_sharing_align) std::atomic_flag m_producing {};
+        alignas(false_sharing_align) std::atomic_flag m_consuming {};
+
+        static record_cache & thread_cache() noexcept {
+            thread_local record_cache cache {};
+            return cache;
+        }
+
+        hazard_record * acquire_record();
+        void retire(hazard_record *, node *);
+        void scan(hazard_record *);
+
+    public:
+        mpmchp_queue();
+        mpmchp_queue(const mpmchp_queue &) = delete;
+        mpmchp_queue(mpmchp_queue && other) = delete;
+        ~mpmchp_queue();
+
+        mpmchp_queue & operator=(const mpmchp_queue &) = delete;
+        mpmchp_queue & operator=(mpmchp_queue && other) = delete;
+
+        [[nodiscard, maybe_unused]]
+        bool empty() const noexcept {
+            return m_head.load(mo::acquire)->m_next.load(mo::acquire) == nullptr;
+            // return m_head.load(mo::acquire) == m_tail.load(mo::acquire);
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool producing() const noexcept {
+            return m_producing.test(mo::acquire);
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool consuming() const noexcept {
+            return m_consuming.test(mo::acquire);
+        }
+
+        template <typename U> bool enqueue(U &&);
+        [[nodiscard]] std::unique_ptr<T> dequeue();
+        [[maybe_unused]] void escape();
+
+        [[maybe_unused]]
+        void shutdown() noexcept {
+            m_producing.clear(mo::release);
+        }
+
+        [[maybe_unused]]
+        void stop() noexcept {
+            m_producing.clear(mo::release);
+            m_consuming.clear(mo::release);
+        }
+    };
+
+    template<typename T, int R>
+    requires (R >= 2)
+    struct mpmchp_queue<T, R>::node final {
+        std::unique_ptr<T> m_data;
+        std::atomic<node *> m_next { nullptr };
+
+        node() : m_data { nullptr } {}
+        node(const node &) = delete;
+        node(node && other) = delete;
+
+        template <typename U>
+        explicit node(U && value) // NOLINT(*-forwarding-reference-overload)
+        : m_data { std::make_unique<T>(std::forward<U>(value)) } {}
+
+        ~node() = default;
+
+        node & operator=(const node &) = delete;
+        node & operator=(node && other) = delete;
+    };
+
+    template<typename T, int R>
+    requires (R >= 2)
+    struct alignas(false_sharing_align) mpmchp_queue<T, R>::hazard_record final {
+        std::atomic<node *> m_hazard[c_hazards] {};
+        std::atomic<std::thread::id> m_owner {};
+        hazard_record * m_next { nullptr };
+        std::vector<node *> m_retired {};
+        std::vector<node *> m_protected {};
+
+        hazard_record() = default;
+        hazard_record(const hazard_record &) = delete;
+        hazard_record(hazard_record && other) = delete;
+
+        ~hazard_record() {
+            for (node * retired : m_retired) {
+                delete retired;
+            }
+        }
+
+        hazard_record & operator=(const hazard_record &) = delete;
+        hazard_record & operator=(hazard_record && other) = delete;
+
+        void clear() noexcept {
+            for (auto & hazard : m_hazard) {
+                hazard.store(nullptr, mo::release);
+            }
+        }
+    };
+
+    template<typename T, int R>
+    requires (R >= 2)
+    mpmchp_queue<T, R>::mpmchp_queue() : m_head { new node }, m_tail { m_head.load(mo::relaxed) } {
+        m_producing.test_and_set(mo::acquire);
+        m_consuming.test_and_set(mo::acquire);
+    }
+
+    template<typename T, int R>
+    requires (R >= 2)
+    mpmchp_queue<T, R>::~mpmchp_queue() {
+        stop();
+
+        node * current { m_head.load(mo::relaxed) };
+        while (current) {
+            node * next { current->m_next.load(mo::relaxed) };
+            delete current;
+            current = next;
+        }
+
+        hazard_record * record { m_records.load(mo::relaxed) };
+        while (record) {
+            hazard_record * next { record->m_next };
+            delete record;
+            record = next;
+        }
+
+        if (auto & cache = thread_cache(); cache.m_queue_id == m_id) {
+            cache = {};
+        }
+    }
+
+    template<typename T, int R>
+    requires (R >= 2)
+    auto mpmchp_queue<T, R>::acquire_record() -> hazard_record * {
+        auto & cache = thread_cache();
+        if (cache.m_queue_id == m_id) {
+            return cache.m_record;
+        }
+
+        const auto self = std::this_thread::get_id();
+        hazard_record * head { m_records.load(mo::acquire) };
+
+        for (hazard_record * record { head }; record; record = record->m_next) {
+            if (record->m_owner.load(mo::acquire) == self) {
+                cache = { m_id, record };
+                return record;
+            }
+        }
+
+        for (hazard_record * record { head }; record; record = record->m_next) {
+            std::thread::id vacant {};
+            if (record->m_owner.compare_exchange_strong(vacant, self, mo::acq_rel, mo::relaxed)) {
+                cache = { m_id, record };
+                return record;
+            }
+        }
+
+        auto record = new hazard_record {};
+        record->m_owner.store(self, mo::relaxed);
+        record->m_retired.reserve(static_cast<size_t>(R));
+        record->m_next = head;
+        while (!m_records.compare_exchange_weak(record->m_next, record, mo::acq_rel, mo::acquire)) {}
+        cache = { m_id, record };
+        return record;
+    }
+
+    template<typename T, int R>
+    requires (R >= 2)
+    void mpmchp_queue<T, R>::retire(hazard_record * record, node * retired) {
+        record->m_retired.push_back(retired);
+        if (record->m_retired.size() >= static_cast<size_t>(R)) {
+            scan(record);
+        }
+    }
+
+    template<typename T, int R>
+    requires (R >= 2)
+    void mpmchp_queue<T, R>::scan(hazard_record * record) {
+        auto & protected_nodes = record->m_protected;
+        protected_nodes.clear();
+
+        for (hazard_record * it { m_records.load(mo::acquire) }; it; it = it->m_next) {
+            for (auto & hazard : it->m_hazard) {
+                if (node * guarded { hazard.load(mo::seq_cst) }; guarded) {
+                    protected_nodes.push_back(guarded);
+                }
+            }
+        }
+
+        std::ranges::sort(protected_nodes);
+
+        const auto kept = std::ranges::partition(
+            record->m_retired,
+            [& protected_nodes] (node * retired) { return std::ranges::binary_search(protected_nodes, retired); }
+        );
+        for (node * retired : kept) {
+            delete retired;
+        }
+        record->m_retired.erase(kept.begin(), kept.end());
+    }
+
+    template<typename T, int R>
+    requires (R >= 2)
+    template<typename U>
+    bool mpmchp_queue<T, R>::enqueue(U && value) {
+        if (!m_producing.test(mo::acquire)) {
+            return false;
+        }
+
+        hazard_record * record { acquire_record() };
+        node * new_node { new node(std::forward<U>(value)) };
+
+        while (m_producing.test(mo::acquire)) {
+            node * tail { m_tail.load(mo::acquire) };
+            record->m_hazard[0].store(tail, mo::seq_cst);
+            if (m_tail.load(mo::seq_cst) != tail) {
+                continue;
+            }
+
+            node * next { tail->m_next.load(mo::acquire) };
+            if (m_tail.load(mo::acquire) != tail) {
+                continue;
+            }
+
+            if (next) {
+                m_tail.compare_exchange_strong(tail, next, mo::acq_rel, mo::acquire);
+                continue;
+            }
+
+            if (tail->m_next.compare_exchange_strong(next, new_node, mo::acq_rel, mo::acquire)) {
+                m_tail.compare_exchange_strong(tail, new_node, mo::acq_rel, mo::acquire);
+                record->clear();
+                return true;
+            }
+        }
+
+        record->clear();
+        delete new_node;
+        return false;
+    }
+
+    template<typename T, int R>
+    requires (R >= 2)
+    [[nodiscard]]
+    std::unique_ptr<T> mpmchp_queue<T, R>::dequeue() {
+        if (!m_consuming.test(mo::acquire)) {
+            return { nullptr };
+        }
+
+        hazard_record * record { acquire_record() };
+
+        while (m_consuming.test(mo::acquire)) {
+            node * head { m_head.load(mo::acquire) };
+            record->m_hazard[0].store(head, mo::seq_cst);
+            if (m_head.load(mo::seq_cst) != head) {
+                continue;
+            }
+
+            node * tail { m_tail.load(mo::acquire) };
+            node * first { head->m_next.load(mo::acquire) };
+            record->m_hazard[1].store(first, mo::seq_cst);
+            if (m_head.load(mo::seq_cst) != head) {
+                continue;
+            }
+
+            if (first == nullptr) {
+                record->clear();
+                return { nullptr };
+            }
+
+            if (head == tail) {
+                m_tail.compare_exchange_strong(tail, first, mo::acq_rel, mo::acquire);
+                continue;
+            }
+
+            if (m_head.compare_exchange_strong(head, first, mo::acq_rel, mo::acquire)) {
+                auto result = std::move(first->m_data);
+                record->clear();
+                retire(record, head);
+                return result;
+            }
+        }
+
+        record->clear();
+        return { nullptr };
+    }
+
+    template<typename T, int R>
+    requires (R >= 2)
+    [[maybe_unused]]
+    void mpmchp_queue<T, R>::escape() {
+        auto & cache = thread_cache();
+        if (cache.m_queue_id != m_id) {
+            return;
+        }
+
+        hazard_record * record { cache.m_record };
+        record->clear();
+        scan(record);
+        record->m_owner.store(std::thread::id {}, mo::release);
+        cache = {};
+    }
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Implementation of an MPMC Queue with two locks (Michael & Scott).
+ * Producers are serialized by the tail lock and consumers by the head lock. The locks are placed on separate cache
+ * lines.
+ * With flat combining (F = true) a consumer publishes its request in one of K slots, and whichever consumer holds
+ * the head lock serves all pending requests in one pass.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include "types.hpp"
+#include "spinlock.hpp"
+
+namespace xtxn {
+    constexpr unsigned queue_default_combining_slots [[maybe_unused]] { 0x20 };
+
+    template<typename T, bool F = false, unsigned K = queue_default_combining_slots>
+    requires (K > 0)
+    class alignas(true_sharing_align) mpmctl_queue final {
+        struct node;
+        struct request;
+        using mo = std::memory_order;
+
+        enum class request_state : uint32_t { vacant, pending, served };
+
+        struct alignas(false_sharing_align) {
+            std::atomic<node *> m_node;
+            spinlock<> m_spinlock {};
+        } m_head;
+        struct alignas(false_sharing_align) {
+            std::atomic<node *> m_node;
+            spinlock<> m_spinlock {};
+        } m_tail;
+        alignas(false_sharing_align) std::atomic_flag m_producing {};
+        alignas(false_sharing_align) std::atomic_flag m_consuming {};
+        std::unique_ptr<request[]> m_requests {};
+
+        std::unique_ptr<T> pop();
+        std::unique_ptr<T> combine(request &);
+        void serve_requests();
+
+        static unsigned thread_slot() noexcept {
+            static std::atomic_uint s_next_slot { 0 };
+            thread_local const unsigned slot { s_next_slot.fetch_add(1, mo::relaxed) % K };
+            return slot;
+        }
+
+    public:
+        static constexpr bool c_flat_combining [[maybe_unused]] { F };
+
+        mpmctl_queue();
+        mpmctl_queue(const mpmctl_queue &) = delete;
+        mpmctl_queue(mpmctl_queue && other) = delete;
+        ~mpmctl_queue();
+
+        mpmctl_queue & operator=(const mpmctl_queue &) = delete;
+        mpmctl_queue & operator=(mpmctl_queue && other) = delete;
+
+        [[nodiscard, maybe_unused]]
+        bool empty() const noexcept {
+            return m_head.m_node.load(mo::acquire)->m_next.load(mo::acquire) == nullptr;
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool producing() const noexcept {
+            return m_producing.test(mo::acquire);
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool consuming() const noexcept {
+            return m_consuming.test(mo::acquire);
+        }
+
+        template <typename U> bool enqueue(U &&);
+        [[nodiscard]] std::unique_ptr<T> dequeue();
+
+        [[maybe_unused]]
+        void shutdown() noexcept {
+            m_producing.clear(mo::release);
+        }
+
+        [[maybe_unused]]
+        void stop() noexcept {
+            m_producing.clear(mo::release);
+            m_consuming.clear(mo::release);
+        }
+    };
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    struct mpmctl_queue<T, F, K>::node final {
+        std::unique_ptr<T> m_data;
+        std::atomic<node *> m_next { nullptr };
+
+        node() : m_data { nullptr } {}
+        node(const node &) = delete;
+        node(node && other) = delete;
+
+        template <typename U>
+        explicit node(U && value) // NOLINT(*-forwarding-reference-overload)
+        : m_data { std::make_unique<T>(std::forward<U>(value)) } {}
+
+        ~node() = default;
+
+        node & operator=(const node &) = delete;
+        node & operator=(node && other) = delete;
+    };
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    struct alignas(false_sharing_align) mpmctl_queue<T, F, K>::request final {
+        std::atomic<request_state> m_state { request_state::vacant };
+        std::unique_ptr<T> m_result { nullptr };
+    };
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    mpmctl_queue<T, F, K>::mpmctl_queue() {
+        node * dummy { new node };
+        m_head.m_node.store(dummy, mo::relaxed);
+        m_tail.m_node.store(dummy, mo::relaxed);
+        if constexpr (F) {
+            m_requests = std::make_unique<request[]>(K);
+        }
+        m_producing.test_and_set(mo::acquire);
+        m_consuming.test_and_set(mo::acquire);
+    }
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    mpmctl_queue<T, F, K>::~mpmctl_queue() {
+        stop();
+
+        std::scoped_lock lock { m_head.m_spinlock, m_tail.m_spinlock };
+
+        node * current { m_head.m_node.load(mo::relaxed) };
+        while (current) {
+            node * next { current->m_next.load(mo::relaxed) };
+            delete current;
+            current = next;
+        }
+    }
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    template<typename U>
+    bool mpmctl_queue<T, F, K>::enqueue(U && value) {
+        if (!m_producing.test(mo::acquire)) {
+            return false;
+        }
+
+        node * new_node { new node(std::forward<U>(value)) };
+
+        std::scoped_lock lock { m_tail.m_spinlock };
+
+        m_tail.m_node.load(mo::relaxed)->m_next.store(new_node, mo::release);
+        m_tail.m_node.store(new_node, mo::relaxed);
+
+        return true;
+    }
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    [[nodiscard]]
+    std::unique_ptr<T> mpmctl_queue<T, F, K>::dequeue() {
+        if (!m_consuming.test(mo::acquire)) {
+            return { nullptr };
+        }
+
+        if constexpr (F) {
+            const unsigned first { thread_slot() };
+            for (unsigned i { 0 }; i < K; ++i) {
+                request & slot { m_requests[(first + i) % K] };
+                auto state = request_state::vacant;
+                if (slot.m_state.compare_exchange_strong(state, request_state::pending, mo::acq_rel, mo::relaxed)) {
+                    return combine(slot);
+                }
+            }
+        }
+
+        std::scoped_lock lock { m_head.m_spinlock };
+        return pop();
+    }
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    std::unique_ptr<T> mpmctl_queue<T, F, K>::pop() {
+        node * head { m_head.m_node.load(mo::relaxed) };
+        node * next { head->m_next.load(mo::acquire) };
+        if (!next) {
+            return { nullptr };
+        }
+        auto result = std::move(next->m_data);
+        m_head.m_node.store(next, mo::release);
+        delete head;
+        return result;
+    }
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    std::unique_ptr<T> mpmctl_queue<T, F, K>::combine(request & slot) {
+        for (unsigned spins { 0 }; slot.m_state.load(mo::acquire) != request_state::served; ++spins) {
+            if (m_head.m_spinlock.try_lock()) {
+                serve_requests();
+                m_head.m_spinlock.unlock();
+            } else if (spins < spinlock_spin_limit) {
+                _mm_pause();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        auto result = std::move(slot.m_result);
+        slot.m_state.store(request_state::vacant, mo::release);
+        return result;
+    }
+
+    template<typename T, bool F, unsigned K>
+    requires (K > 0)
+    void mpmctl_queue<T, F, K>::serve_requests() {
+        for (unsigned i { 0 }; i < K; ++i) {
+            request & slot { m_requests[i] };
+            if (slot.m_state.load(mo::acquire) == request_state::pending) {
+                slot.m_result = pop();
+                slot.m_state.store(request_state::served, mo::release);
+            }
+        }
+    }
+}
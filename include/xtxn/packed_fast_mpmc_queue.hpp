@@ -0,0 +1,237 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Fixed-size queue of small values (handles, indices) where the slot state and the value share one 64-bit atomic word:
+ * the low 32 bits hold the value, bit 32 tells the slot is ready. A producer publishes with a single CAS from free to
+ * ready+value and a consumer takes the value with a single CAS back to free, so there are no slot accessors, no
+ * separate payload array and no second store. A consumer that sees the same word again after another consumer has
+ * taken it and a producer has put the same value back just takes the new item, so such an ABA is harmless.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <concepts>
+#include <limits>
+#include <type_traits>
+#include "types.hpp"
+#include "algo.hpp"
+#include "fast_mpmc_queue_commons.hpp"
+
+namespace xtxn {
+    template<typename T>
+    concept packable_payload
+        = std::default_initializable<T> && std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(uint32_t);
+
+    template<
+        packable_payload T,
+        signed S,
+        unsigned A = queue_default_attempts,
+        queue_stats_policy M = queue_no_stats,
+        wrap_policy W = wrap_policy::subtract
+    >
+    requires (S > 1) && (A > 0) && (!M::c_residence)
+    class alignas(true_sharing_align) packed_fast_mpmc_queue {
+        using mo = std::memory_order;
+        using state = queue_slot_state;
+
+        static constexpr uint64_t c_free { 0 };
+        static constexpr uint64_t c_ready { uint64_t { 1 } << 32 };
+
+        struct alignas(false_sharing_align) {
+            std::atomic_uint_fast64_t m_index { 0 };
+            std::atomic_flag m_enable {};
+        } m_producer;
+        struct alignas(false_sharing_align) {
+            std::atomic_uint_fast64_t m_index { 0 };
+            std::atomic_flag m_enable {};
+        } m_consumer;
+        alignas(false_sharing_align) std::atomic_int_fast32_t m_free { S };
+        alignas(false_sharing_align) std::atomic_uint64_t m_slots[static_cast<size_t>(S)] {};
+        [[no_unique_address]] M m_stats {};
+
+        static uint64_t pack(const T & value) noexcept {
+            uint32_t bits { 0 };
+            std::memcpy(&bits, &value, sizeof(T));
+            return c_ready | bits;
+        }
+
+        static T unpack(const uint64_t word) noexcept {
+            const auto bits = static_cast<uint32_t>(word);
+            T value {};
+            std::memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+
+        queue_slot_status consumer_failure() const noexcept {
+            if (!m_consumer.m_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free.load(mo::acquire) < S ? queue_slot_status::contended : queue_slot_status::empty;
+        }
+
+    public:
+        using payload_type [[maybe_unused]] = T;
+        using size_type = decltype(S);
+
+        static constexpr size_type c_size [[maybe_unused]] { S };
+        static constexpr unsigned c_default_attempts [[maybe_unused]] { A };
+        static constexpr bool c_stats [[maybe_unused]] { M::c_enabled };
+        static constexpr bool c_trace [[maybe_unused]] { M::c_trace };
+        static constexpr wrap_policy c_wrap_policy [[maybe_unused]] { W };
+
+        packed_fast_mpmc_queue() noexcept(std::is_nothrow_default_constructible_v<M>);
+        packed_fast_mpmc_queue(const packed_fast_mpmc_queue &) = delete;
+        packed_fast_mpmc_queue(packed_fast_mpmc_queue &&) = delete;
+        ~packed_fast_mpmc_queue() = default;
+
+        packed_fast_mpmc_queue & operator=(const packed_fast_mpmc_queue &) = delete;
+        packed_fast_mpmc_queue & operator=(packed_fast_mpmc_queue &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        size_type capacity() const noexcept { // NOLINT
+            return S;
+        }
+
+        [[nodiscard, maybe_unused]]
+        size_type free_slots() const noexcept {
+            return static_cast<size_type>(m_free.load(mo::relaxed));
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool empty() const noexcept {
+            return m_free.load(mo::acquire) == S;
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool producing() const noexcept {
+            return m_producer.m_enable.test(mo::acquire);
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool consuming() const noexcept {
+            return m_consumer.m_enable.test(mo::acquire);
+        }
+
+        /** Publishes the value in a free slot **/
+        [[maybe_unused]] queue_slot_status push(const T & value, unsigned = c_default_attempts) noexcept;
+
+        /** Takes a value out of a ready slot, the value is left untouched on failure **/
+        [[maybe_unused]] queue_slot_status pop(T & value, unsigned = 0) noexcept;
+
+        [[nodiscard, maybe_unused]]
+        auto stats() const noexcept requires (M::c_enabled) {
+            return m_stats.snapshot();
+        }
+
+        [[nodiscard, maybe_unused]]
+        auto trace() const requires (M::c_trace) {
+            return m_stats.records();
+        }
+
+        [[maybe_unused]]
+        bool dump_trace(auto && target) const requires (M::c_trace) {
+            return m_stats.dump(target);
+        }
+
+        [[maybe_unused]]
+        void shutdown() noexcept {
+            m_producer.m_enable.clear(mo::release);
+        }
+
+        [[maybe_unused]]
+        void stop() noexcept {
+            m_producer.m_enable.clear(mo::release);
+            m_consumer.m_enable.clear(mo::release);
+        }
+    };
+
+    template<packable_payload T, signed S, unsigned A, queue_stats_policy M, wrap_policy W>
+    requires (S > 1) && (A > 0) && (!M::c_residence)
+    packed_fast_mpmc_queue<T, S, A, M, W>::packed_fast_mpmc_queue()
+    noexcept(std::is_nothrow_default_constructible_v<M>) {
+        m_producer.m_enable.test_and_set(mo::acquire);
+        m_consumer.m_enable.test_and_set(mo::acquire);
+    }
+
+    template<packable_payload T, signed S, unsigned A, queue_stats_policy M, wrap_policy W>
+    requires (S > 1) && (A > 0) && (!M::c_residence)
+    queue_slot_status
+    packed_fast_mpmc_queue<T, S, A, M, W>::push(const T & value, unsigned slot_acquire_attempts) noexcept {
+        assert(slot_acquire_attempts > 0);
+
+        [[maybe_unused]] unsigned probes { 0 };
+
+        if (!m_producer.m_enable.test(mo::acquire)) {
+            m_stats.on_acquire(queue_side::producer, queue_slot_status::stopped, probes, S);
+            return queue_slot_status::stopped;
+        }
+
+        // A slot is reserved up front, so the free count never exceeds the capacity
+        if (m_free.fetch_sub(1, mo::acq_rel) <= 0) {
+            m_free.fetch_add(1, mo::acq_rel);
+            m_stats.on_acquire(queue_side::producer, queue_slot_status::full, probes, S);
+            return queue_slot_status::full;
+        }
+
+        const auto word = pack(value);
+
+        do {
+            for (auto count = S; count && m_producer.m_enable.test(mo::acquire); --count) {
+                ++probes;
+                auto expected = c_free;
+                auto index = iterate_post_inc<S, W>(m_producer.m_index);
+                if (m_slots[index].compare_exchange_strong(expected, word, mo::acq_rel, mo::relaxed)) {
+                    m_stats.on_transition(index, state::free, state::ready);
+                    m_stats.on_acquire(queue_side::producer, queue_slot_status::acquired, probes, S);
+                    return queue_slot_status::acquired;
+                }
+            }
+        } while (--slot_acquire_attempts);
+
+        m_free.fetch_add(1, mo::acq_rel);
+        const auto status = m_producer.m_enable.test(mo::acquire)
+            ? queue_slot_status::contended
+            : queue_slot_status::stopped;
+        m_stats.on_acquire(queue_side::producer, status, probes, S);
+        return status;
+    }
+
+    template<packable_payload T, signed S, unsigned A, queue_stats_policy M, wrap_policy W>
+    requires (S > 1) && (A > 0) && (!M::c_residence)
+    queue_slot_status
+    packed_fast_mpmc_queue<T, S, A, M, W>::pop(T & value, unsigned slot_acquire_attempts) noexcept {
+        [[maybe_unused]] unsigned probes { 0 };
+
+        for (
+            auto budget = slot_acquire_attempts
+                ? static_cast<uint_fast64_t>(slot_acquire_attempts) * static_cast<uint_fast64_t>(S)
+                : std::numeric_limits<uint_fast64_t>::max();
+            budget && m_consumer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) < S;
+            --budget
+        ) {
+            ++probes;
+            auto index = iterate_post_inc<S, W>(m_consumer.m_index);
+            auto word = m_slots[index].load(mo::acquire);
+            if ((word & c_ready) && m_slots[index].compare_exchange_strong(word, c_free, mo::acq_rel, mo::relaxed)) {
+                value = unpack(word);
+                m_free.fetch_add(1, mo::acq_rel);
+                m_stats.on_transition(index, state::ready, state::free);
+                m_stats.on_acquire(queue_side::consumer, queue_slot_status::acquired, probes, S);
+                return queue_slot_status::acquired;
+            }
+        }
+
+        const auto status = consumer_failure();
+        m_stats.on_acquire(queue_side::consumer, status, probes, S);
+        return status;
+    }
+
+    template<class T>
+    concept any_packed_fast_mpmc_queue = requires(T t) {
+        [] <packable_payload U, int32_t S, unsigned A, queue_stats_policy M, wrap_policy W>
+        (packed_fast_mpmc_queue<U, S, A, M, W> &) {} (t);
+    };
+}
@@ -0,0 +1,391 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Fixed-size queue of up to 64 slots (mailboxes) where the slot states are two 64-bit atomic bitmaps instead of an
+ * array of states: a set bit in the free bitmap is a free slot, a set bit in the ready bitmap a ready one, and a locked
+ * slot is in neither. A side claims a slot by clearing its bit (fetch_and, the bit test-and-reset) and releases it by
+ * setting the bit in the other bitmap (fetch_or). The slot is found with countr_zero of the bitmap rotated to the
+ * side's cursor, so the slots are still taken in ring order. The number of free slots is the population count of the
+ * free bitmap, there is no separate counter. The whole control block fits in one cache line.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <utility>
+#include "types.hpp"
+#include "fast_mpmc_queue_commons.hpp"
+
+namespace xtxn {
+    template<
+        std::default_initializable T,
+        signed S,
+        bool C = queue_default_auto_completion,
+        unsigned A = queue_default_attempts,
+        queue_stats_policy M = queue_no_stats
+    >
+    requires (S > 1) && (S <= 64) && (A > 0)
+    class alignas(true_sharing_align) small_fast_mpmc_queue {
+        using slot_completion = queue_slot_completion<C>;
+        class producer_accessor;
+        class consumer_accessor;
+        using mo = std::memory_order;
+        using state = queue_slot_state;
+
+        static constexpr bool c_ntdct = std::is_nothrow_default_constructible_v<T>;
+        static constexpr uint64_t c_all { std::numeric_limits<uint64_t>::max() >> (64 - S) };
+
+        std::atomic_uint64_t m_free_bits { c_all };
+        std::atomic_uint64_t m_ready_bits { 0 };
+        std::atomic_uint32_t m_producer_cursor { 0 };
+        std::atomic_uint32_t m_consumer_cursor { 0 };
+        std::atomic_flag m_producer_enable {};
+        std::atomic_flag m_consumer_enable {};
+        [[no_unique_address]] queue_slot_stamps<M::c_residence, static_cast<size_t>(S)> m_stamps {};
+        alignas(false_sharing_align) T m_payload[static_cast<size_t>(S)] {};
+        [[no_unique_address]] M m_stats {};
+
+        /** The first set bit at or after the cursor, in ring order **/
+        static uint32_t pick(const uint64_t bits, const uint32_t cursor) noexcept {
+            assert(bits);
+            const auto offset = static_cast<uint32_t>(std::countr_zero(std::rotr(bits, static_cast<int>(cursor))));
+            return (cursor + offset) & 63u;
+        }
+
+        static uint32_t next(const uint32_t index) noexcept {
+            return index + 1 < static_cast<uint32_t>(S) ? index + 1 : 0;
+        }
+
+        queue_slot_status producer_failure() const noexcept {
+            if (!m_producer_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free_bits.load(mo::acquire) ? queue_slot_status::contended : queue_slot_status::full;
+        }
+
+        queue_slot_status consumer_failure() const noexcept {
+            if (!m_consumer_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free_bits.load(mo::acquire) != c_all ? queue_slot_status::contended : queue_slot_status::empty;
+        }
+
+    public:
+        using payload_type [[maybe_unused]] = T;
+        using size_type = decltype(S);
+        using offset_type = uint32_t;
+
+        static constexpr offset_type c_invalid_index { std::numeric_limits<offset_type>::max() };
+        static constexpr size_type c_size [[maybe_unused]] { S };
+        static constexpr bool c_auto_complete [[maybe_unused]] { C };
+        static constexpr unsigned c_default_attempts [[maybe_unused]] { A };
+        static constexpr bool c_stats [[maybe_unused]] { M::c_enabled };
+        static constexpr bool c_trace [[maybe_unused]] { M::c_trace };
+
+        small_fast_mpmc_queue() noexcept(c_ntdct && std::is_nothrow_default_constructible_v<M>);
+        small_fast_mpmc_queue(const small_fast_mpmc_queue &) = delete;
+        small_fast_mpmc_queue(small_fast_mpmc_queue &&) = delete;
+        ~small_fast_mpmc_queue() = default;
+
+        small_fast_mpmc_queue & operator=(const small_fast_mpmc_queue &) = delete;
+        small_fast_mpmc_queue & operator=(small_fast_mpmc_queue &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        size_type capacity() const noexcept { // NOLINT
+            return S;
+        }
+
+        [[nodiscard, maybe_unused]]
+        size_type free_slots() const noexcept {
+            return static_cast<size_type>(std::popcount(m_free_bits.load(mo::relaxed)));
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool empty() const noexcept {
+            return m_free_bits.load(mo::acquire) == c_all;
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool producing() const noexcept {
+            return m_producer_enable.test(mo::acquire);
+        }
+
+        [[nodiscard, maybe_unused]]
+        bool consuming() const noexcept {
+            return m_consumer_enable.test(mo::acquire);
+        }
+
+        [[nodiscard]] producer_accessor producer_slot(unsigned = c_default_attempts) noexcept;
+        [[nodiscard]] consumer_accessor consumer_slot(unsigned = 0) noexcept;
+
+        [[nodiscard, maybe_unused]]
+        auto stats() const noexcept requires (M::c_enabled) {
+            return m_stats.snapshot();
+        }
+
+        [[nodiscard, maybe_unused]]
+        auto trace() const requires (M::c_trace) {
+            return m_stats.records();
+        }
+
+        [[maybe_unused]]
+        bool dump_trace(auto && target) const requires (M::c_trace) {
+            return m_stats.dump(target);
+        }
+
+        [[maybe_unused]]
+        void shutdown() noexcept {
+            m_producer_enable.clear(mo::release);
+        }
+
+        [[maybe_unused]]
+        void stop() noexcept {
+            m_producer_enable.clear(mo::release);
+            m_consumer_enable.clear(mo::release);
+        }
+    };
+
+    template<std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M>
+    requires (S > 1) && (S <= 64) && (A > 0)
+    class small_fast_mpmc_queue<T, S, C, A, M>::producer_accessor : public slot_completion {
+    protected:
+        small_fast_mpmc_queue * const m_queue { nullptr };
+        offset_type const m_index { c_invalid_index };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+
+    public:
+        producer_accessor() = delete;
+
+        explicit producer_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
+        producer_accessor(const producer_accessor &) = delete;
+        producer_accessor(producer_accessor &&) = delete;
+
+        producer_accessor(small_fast_mpmc_queue * queue, offset_type index) noexcept
+        : slot_completion {}, m_queue { queue }, m_index { index } {
+            assert(m_queue);
+            assert(m_index < S);
+        }
+
+        ~producer_accessor() override;
+
+        producer_accessor & operator=(const producer_accessor &) = delete;
+        producer_accessor & operator=(producer_accessor &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        T * operator->() noexcept {
+            assert(m_queue);
+            assert(m_index < S);
+            return &m_queue->m_payload[m_index];
+        }
+
+        [[nodiscard, maybe_unused]]
+        T & operator*() noexcept {
+            assert(m_queue);
+            assert(m_index < S);
+            return m_queue->m_payload[m_index];
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() noexcept {
+            assert((!m_queue && m_index == c_invalid_index) || (m_queue && m_index < S));
+            return m_queue;
+        }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+    };
+
+    template<std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M>
+    requires (S > 1) && (S <= 64) && (A > 0)
+    small_fast_mpmc_queue<T, S, C, A, M>::producer_accessor::~producer_accessor() {
+        if (m_queue) {
+            const auto bit = uint64_t { 1 } << m_index;
+            if constexpr (slot_completion::c_auto_complete) {
+                m_queue->m_stamps.stamp(m_index);
+                m_queue->m_stats.on_transition(m_index, state::prod_locked, state::ready);
+                m_queue->m_ready_bits.fetch_or(bit, mo::acq_rel);
+            } else {
+                if (slot_completion::m_complete) {
+                    m_queue->m_stamps.stamp(m_index);
+                    m_queue->m_stats.on_transition(m_index, state::prod_locked, state::ready);
+                    m_queue->m_ready_bits.fetch_or(bit, mo::acq_rel);
+                } else {
+                    m_queue->m_stats.on_transition(m_index, state::prod_locked, state::free);
+                    m_queue->m_free_bits.fetch_or(bit, mo::acq_rel);
+                }
+            }
+        }
+    }
+
+    template<std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M>
+    requires (S > 1) && (S <= 64) && (A > 0)
+    class small_fast_mpmc_queue<T, S, C, A, M>::consumer_accessor : public slot_completion {
+    protected:
+        small_fast_mpmc_queue * const m_queue { nullptr };
+        offset_type const m_index { c_invalid_index };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+
+    public:
+        consumer_accessor() = delete;
+
+        explicit consumer_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
+        consumer_accessor(const consumer_accessor &) = delete;
+        consumer_accessor(consumer_accessor &&) = delete;
+
+        consumer_accessor(small_fast_mpmc_queue * queue, offset_type index) noexcept
+        : slot_completion {}, m_queue { queue }, m_index { index } {
+            assert(m_queue);
+            assert(m_index < S);
+        }
+
+        ~consumer_accessor() override;
+
+        consumer_accessor & operator=(const consumer_accessor &) = delete;
+        consumer_accessor & operator=(consumer_accessor &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        T * operator->() noexcept {
+            assert(m_queue);
+            assert(m_index < S);
+            return &m_queue->m_payload[m_index];
+        }
+
+        [[nodiscard, maybe_unused]]
+        T & operator*() noexcept {
+            assert(m_queue);
+            assert(m_index < S);
+            return m_queue->m_payload[m_index];
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() noexcept {
+            assert((!m_queue && m_index == c_invalid_index) || (m_queue && m_index < S));
+            return m_queue;
+        }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+    };
+
+    template<std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M>
+    requires (S > 1) && (S <= 64) && (A > 0)
+    small_fast_mpmc_queue<T, S, C, A, M>::consumer_accessor::~consumer_accessor() {
+        if (m_queue) {
+            const auto bit = uint64_t { 1 } << m_index;
+            if constexpr (slot_completion::c_auto_complete) {
+                m_queue->m_stats.on_transition(m_index, state::cons_locked, state::free);
+                m_queue->m_free_bits.fetch_or(bit, mo::acq_rel);
+            } else {
+                if (slot_completion::m_complete) {
+                    m_queue->m_stats.on_transition(m_index, state::cons_locked, state::free);
+                    m_queue->m_free_bits.fetch_or(bit, mo::acq_rel);
+                } else {
+                    m_queue->m_stats.on_transition(m_index, state::cons_locked, state::ready);
+                    m_queue->m_ready_bits.fetch_or(bit, mo::acq_rel);
+                }
+            }
+        }
+    }
+
+    template<std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M>
+    requires (S > 1) && (S <= 64) && (A > 0)
+    small_fast_mpmc_queue<T, S, C, A, M>::small_fast_mpmc_queue()
+    noexcept(c_ntdct && std::is_nothrow_default_constructible_v<M>) {
+        m_producer_enable.test_and_set(mo::acquire);
+        m_consumer_enable.test_and_set(mo::acquire);
+    }
+
+    template<std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M>
+    requires (S > 1) && (S <= 64) && (A > 0)
+    auto
+    small_fast_mpmc_queue<T, S, C, A, M>::producer_slot(unsigned slot_acquire_attempts)
+    noexcept -> producer_accessor {
+        assert(slot_acquire_attempts > 0);
+
+        [[maybe_unused]] unsigned probes { 0 };
+
+        if (!m_producer_enable.test(mo::acquire)) {
+            m_stats.on_acquire(queue_side::producer, queue_slot_status::stopped, probes, S);
+            return producer_accessor { queue_slot_status::stopped };
+        }
+
+        do {
+            for (auto count = S; count && m_producer_enable.test(mo::acquire); --count) {
+                const auto bits = m_free_bits.load(mo::acquire);
+                if (!bits) {
+                    break;
+                }
+                ++probes;
+                const auto index = pick(bits, m_producer_cursor.load(mo::relaxed));
+                const auto bit = uint64_t { 1 } << index;
+                if (m_free_bits.fetch_and(~bit, mo::acq_rel) & bit) {
+                    m_producer_cursor.store(next(index), mo::relaxed);
+                    m_stats.on_transition(index, state::free, state::prod_locked);
+                    m_stats.on_acquire(queue_side::producer, queue_slot_status::acquired, probes, S);
+                    return { this, index };
+                }
+            }
+        } while (--slot_acquire_attempts);
+
+        const auto status = producer_failure();
+        m_stats.on_acquire(queue_side::producer, status, probes, S);
+        return producer_accessor { status };
+    }
+
+    template<std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M>
+    requires (S > 1) && (S <= 64) && (A > 0)
+    auto
+    small_fast_mpmc_queue<T, S, C, A, M>::consumer_slot(unsigned slot_acquire_attempts)
+    noexcept -> consumer_accessor {
+        [[maybe_unused]] unsigned probes { 0 };
+
+        for (
+            auto budget = slot_acquire_attempts
+                ? static_cast<uint_fast64_t>(slot_acquire_attempts) * static_cast<uint_fast64_t>(S)
+                : std::numeric_limits<uint_fast64_t>::max();
+            budget && m_consumer_enable.test(mo::acquire) && m_free_bits.load(mo::acquire) != c_all;
+            --budget
+        ) {
+            ++probes;
+            const auto bits = m_ready_bits.load(mo::acquire);
+            if (!bits) {
+                continue;
+            }
+            const auto index = pick(bits, m_consumer_cursor.load(mo::relaxed));
+            const auto bit = uint64_t { 1 } << index;
+            if (m_ready_bits.fetch_and(~bit, mo::acq_rel) & bit) {
+                m_consumer_cursor.store(next(index), mo::relaxed);
+                m_stats.on_transition(index, state::ready, state::cons_locked);
+                m_stats.on_acquire(queue_side::consumer, queue_slot_status::acquired, probes, S);
+                m_stats.on_residence(m_stamps.elapsed(index));
+                return { this, index };
+            }
+        }
+
+        const auto status = consumer_failure();
+        m_stats.on_acquire(queue_side::consumer, status, probes, S);
+        return consumer_accessor { status };
+    }
+
+    template<class T>
+    concept any_small_fast_mpmc_queue = requires(T t) {
+        [] <std::default_initializable U, int32_t S, bool C, unsigned A, queue_stats_policy M>
+        (small_fast_mpmc_queue<U, S, C, A, M> &) {} (t);
+    };
+}
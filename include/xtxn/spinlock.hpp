@@ -1,18 +1,45 @@
 // Copyright (c) 2025-2026 Vitaly Anasenko
 // Distributed under the MIT License, see accompanying file LICENSE.txt
 
+/**
+ * Spinlock policies:
+ * - pause, yield_thread, wait_flag, active - test-and-set flag with the specified waiting strategy;
+ * - backoff - test-and-test-and-set flag with exponential backoff;
+ * - ticket - FIFO ticket lock;
+ * - mcs - MCS queue lock, every waiter spins on its own cache line; the queue nodes come from a per-thread pool of
+ *   spinlock_mcs_max_nesting nodes, locks nested deeper allocate their nodes on the heap, so its lock() and
+ *   try_lock() are not noexcept and throw std::bad_alloc if that allocation fails;
+ * - adaptive - spins for a self-calibrated number of iterations, then parks the thread with atomic wait.
+ * The queued policies (ticket, mcs) yield the thread after spinlock_spin_limit unsuccessful spins, so that an
+ * oversubscribed system still makes progress.
+ */
+
 #pragma once
 
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <functional>
+#include <iterator>
 #include <thread>
 #if defined(_MSC_VER) && !defined(__clang__)
 #   include <intrin.h> // NOLINT
 #else
 #   include <immintrin.h> // NOLINT
 #endif
+#include "types.hpp"
 
 namespace xtxn {
-    enum class spin { pause, yield_thread, wait_flag, active };
+    enum class spin { pause, yield_thread, wait_flag, active, backoff, ticket, mcs, adaptive };
+
+    constexpr unsigned spinlock_spin_limit [[maybe_unused]] { 0x100 };
+    constexpr unsigned spinlock_backoff_limit [[maybe_unused]] { 0x400 };
+    constexpr uint32_t spinlock_adaptive_initial_spins [[maybe_unused]] { 0x80 };
+    constexpr uint32_t spinlock_adaptive_max_spins [[maybe_unused]] { 0x2'000 };
+    constexpr unsigned spinlock_mcs_max_nesting [[maybe_unused]] { 0x10 };
+    static_assert(spinlock_mcs_max_nesting <= 32, "The MCS node pool is tracked by a 32-bit mask");
 
     template<spin P = spin::pause>
     class spinlock {
@@ -28,6 +55,7 @@ namespace xtxn {
         spinlock & operator=(spinlock &&) = delete;
 
         void lock() noexcept {
+            [[maybe_unused]] unsigned backoff { 1 };
             while (m_flag.test_and_set(std::memory_order_acquire)) {
                 if constexpr (P == spin::pause) {
                     _mm_pause();
@@ -35,6 +63,18 @@ namespace xtxn {
                     std::this_thread::yield();
                 } else if constexpr (P == spin::wait_flag) {
                     m_flag.wait(true, std::memory_order_relaxed);
+                } else if constexpr (P == spin::backoff) {
+                    for (unsigned i { backoff }; i; --i) {
+                        _mm_pause();
+                    }
+                    if (backoff < spinlock_backoff_limit) {
+                        backoff <<= 1;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                    while (m_flag.test(std::memory_order_relaxed)) {
+                        _mm_pause();
+                    }
                 }
             }
         }
@@ -51,8 +91,213 @@ namespace xtxn {
         }
     };
 
+    template<>
+    class spinlock<spin::ticket> {
+        alignas(false_sharing_align) std::atomic_uint32_t m_next { 0 };
+        alignas(false_sharing_align) std::atomic_uint32_t m_serving { 0 };
+
+    public:
+        spinlock() = default;
+        spinlock(const spinlock &) = delete;
+        spinlock(spinlock &&) = delete;
+        ~spinlock() noexcept = default;
+
+        spinlock & operator=(const spinlock &) = delete;
+        spinlock & operator=(spinlock &&) = delete;
+
+        void lock() noexcept {
+            const uint32_t ticket { m_next.fetch_add(1, std::memory_order_relaxed) };
+            unsigned spins { 0 };
+            for (;;) {
+                const uint32_t serving { m_serving.load(std::memory_order_acquire) };
+                if (serving == ticket) {
+                    return;
+                }
+                for (uint32_t i { ticket - serving }; i; --i) {
+                    _mm_pause();
+                }
+                if (++spins >= spinlock_spin_limit) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        bool try_lock() noexcept {
+            uint32_t serving { m_serving.load(std::memory_order_acquire) };
+            return m_next.compare_exchange_strong(serving, serving + 1, std::memory_order_acquire);
+        }
+
+        void unlock() noexcept {
+            m_serving.store(m_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+    };
+
+    template<>
+    class spinlock<spin::mcs> {
+        struct alignas(false_sharing_align) node {
+            std::atomic<node *> m_next { nullptr };
+            std::atomic_bool m_locked { false };
+        };
+
+        struct node_pool {
+            node m_nodes[spinlock_mcs_max_nesting] {};
+            uint32_t m_busy { 0 };
+
+            node * acquire() {
+                const auto index = static_cast<unsigned>(std::countr_one(m_busy));
+                if (index >= spinlock_mcs_max_nesting) {
+                    return new node {};
+                }
+                m_busy |= 1u << index;
+                return &m_nodes[index];
+            }
+
+            void release(node * item) noexcept {
+                if (std::less<> {}(item, std::begin(m_nodes)) || !std::less<> {}(item, std::end(m_nodes))) {
+                    delete item;
+                    return;
+                }
+                m_busy &= ~(1u << static_cast<unsigned>(item - std::begin(m_nodes)));
+            }
+        };
+
+        static node_pool & pool() noexcept {
+            thread_local node_pool nodes {};
+            return nodes;
+        }
+
+        alignas(false_sharing_align) std::atomic<node *> m_tail { nullptr };
+        node * m_holder { nullptr };
+
+    public:
+        spinlock() = default;
+        spinlock(const spinlock &) = delete;
+        spinlock(spinlock &&) = delete;
+        ~spinlock() noexcept = default;
+
+        spinlock & operator=(const spinlock &) = delete;
+        spinlock & operator=(spinlock &&) = delete;
+
+        void lock() {
+            node * self { pool().acquire() };
+            self->m_next.store(nullptr, std::memory_order_relaxed);
+            self->m_locked.store(true, std::memory_order_relaxed);
+
+            if (node * prev { m_tail.exchange(self, std::memory_order_acq_rel) }; prev) {
+                prev->m_next.store(self, std::memory_order_release);
+                unsigned spins { 0 };
+                while (self->m_locked.load(std::memory_order_acquire)) {
+                    _mm_pause();
+                    if (++spins >= spinlock_spin_limit) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            m_holder = self;
+        }
+
+        bool try_lock() {
+            node * self { pool().acquire() };
+            self->m_next.store(nullptr, std::memory_order_relaxed);
+            node * expected { nullptr };
+            if (m_tail.compare_exchange_strong(expected, self, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                m_holder = self;
+                return true;
+            }
+            pool().release(self);
+            return false;
+        }
+
+        void unlock() noexcept {
+            node * self { m_holder };
+            assert(self);
+            node * next { self->m_next.load(std::memory_order_acquire) };
+            if (!next) {
+                node * expected { self };
+                if (
+                    m_tail.compare_exchange_strong(
+                        expected, nullptr, std::memory_order_acq_rel, std::memory_order_relaxed
+                    )
+                ) {
+                    pool().release(self);
+                    return;
+                }
+                while (!(next = self->m_next.load(std::memory_order_acquire))) {
+                    _mm_pause();
+                }
+            }
+            next->m_locked.store(false, std::memory_order_release);
+            pool().release(self);
+        }
+    };
+
+    template<>
+    class spinlock<spin::adaptive> {
+        enum : uint32_t { unlocked, locked, contended };
+
+        std::atomic_uint32_t m_state { unlocked };
+        std::atomic_uint32_t m_spins { spinlock_adaptive_initial_spins };
+
+        void calibrate(const uint32_t spent) noexcept {
+            const auto spins = static_cast<int64_t>(m_spins.load(std::memory_order_relaxed));
+            const auto adjusted = spins + (static_cast<int64_t>(spent) - spins) / 8;
+            m_spins.store(static_cast<uint32_t>(std::max<int64_t>(adjusted, 1)), std::memory_order_relaxed);
+        }
+
+    public:
+        spinlock() = default;
+        spinlock(const spinlock &) = delete;
+        spinlock(spinlock &&) = delete;
+        ~spinlock() noexcept = default;
+
+        spinlock & operator=(const spinlock &) = delete;
+        spinlock & operator=(spinlock &&) = delete;
+
+        void lock() noexcept {
+            uint32_t state { unlocked };
+            if (m_state.compare_exchange_strong(state, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+
+            const uint32_t limit {
+                std::min(m_spins.load(std::memory_order_relaxed) * 2 + 0x10, spinlock_adaptive_max_spins)
+            };
+            for (uint32_t spent { 0 }; spent < limit; ++spent) {
+                _mm_pause();
+                state = unlocked;
+                if (
+                    m_state.load(std::memory_order_relaxed) == unlocked
+                    && m_state.compare_exchange_weak(
+                        state, locked, std::memory_order_acquire, std::memory_order_relaxed
+                    )
+                ) {
+                    calibrate(spent);
+                    return;
+                }
+            }
+
+            while (m_state.exchange(contended, std::memory_order_acquire) != unlocked) {
+                m_state.wait(contended, std::memory_order_relaxed);
+            }
+            calibrate(limit);
+        }
+
+        bool try_lock() noexcept {
+            uint32_t state { unlocked };
+            return m_state.compare_exchange_strong(state, locked, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        void unlock() noexcept {
+            if (m_state.exchange(unlocked, std::memory_order_release) == contended) {
+                m_state.notify_one();
+            }
+        }
+    };
+
     template class spinlock<spin::pause>;
     template class spinlock<spin::yield_thread>;
     template class spinlock<spin::wait_flag>;
     template class spinlock<spin::active>;
+    template class spinlock<spin::backoff>;
 }
@@ -4,26 +4,42 @@
 #pragma once
 
 #include <cassert>
+#include <chrono>
 #include <concepts>
 #include <limits>
+#include <span>
+#include <utility>
 #include "types.hpp"
 #include "algo.hpp"
 #include "fast_mpmc_queue_commons.hpp"
+#include "fast_mpmc_queue_lease.hpp"
+#include "fast_mpmc_queue_delivery.hpp"
+#include "fast_mpmc_queue_transfer.hpp"
 
 namespace xtxn {
     template<
         std::default_initializable T,
         signed S,
         bool C = queue_default_auto_completion,
-        unsigned A = queue_default_attempts
+        unsigned A = queue_default_attempts,
+        queue_stats_policy M = queue_no_stats,
+        wrap_policy W = wrap_policy::subtract,
+        queue_lease_policy E = queue_lease_policy::none,
+        unsigned R = queue_unlimited_deliveries,
+        queue_transfer_policy X = queue_transfer_policy::plain
     >
-    requires (S > 1) && (A > 0)
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
     class alignas(true_sharing_align) static_fast_mpmc_queue {
         using slot_completion = queue_slot_completion<C>;
+        using slot_lock = queue_slot_lock<E>;
+        using ticket = typename slot_lock::ticket;
         class producer_accessor;
         class consumer_accessor;
+        class producer_span_accessor;
+        class consumer_span_accessor;
         using mo = std::memory_order;
         using state = queue_slot_state;
+        using transfer = queue_transfer<std::is_trivially_copyable_v<T> ? X : queue_transfer_policy::plain>;
 
         static constexpr bool c_ntdct = std::is_nothrow_default_constructible_v<T>;
 
@@ -36,8 +52,30 @@ namespace xtxn {
             std::atomic_flag m_enable {};
         } m_consumer;
         alignas(false_sharing_align) std::atomic_int_fast32_t m_free { S };
-        alignas(false_sharing_align) std::atomic<state> m_state[static_cast<size_t>(S)] {};
+        alignas(false_sharing_align) slot_lock m_state[static_cast<size_t>(S)] {};
+        [[no_unique_address]] queue_slot_stamps<M::c_residence, static_cast<size_t>(S)> m_stamps {};
+        [[no_unique_address]] queue_slot_deliveries<(R > 0), static_cast<size_t>(S)> m_deliveries {};
         alignas(false_sharing_align) T m_payload[static_cast<size_t>(S)] {};
+        [[no_unique_address]] M m_stats {};
+        [[no_unique_address]] queue_lease<E> m_lease {};
+        [[no_unique_address]] queue_dead_letter<T, R> m_dead_letter {};
+
+        queue_slot_status producer_failure() const noexcept {
+            if (!m_producer.m_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free.load(mo::acquire) ? queue_slot_status::contended : queue_slot_status::full;
+        }
+
+        queue_slot_status consumer_failure() const noexcept {
+            if (!m_consumer.m_enable.test(mo::acquire)) {
+                return queue_slot_status::stopped;
+            }
+            return m_free.load(mo::acquire) < S ? queue_slot_status::contended : queue_slot_status::empty;
+        }
+
+        /** Locks up to count consecutive slots from the first one, rolls them back if fewer than least are locked **/
+        size_t lock_run(size_t first, size_t count, size_t least, state from, state to) noexcept;
 
     public:
         using payload_type [[maybe_unused]] = T;
@@ -48,8 +86,19 @@ namespace xtxn {
         static constexpr size_type c_size [[maybe_unused]] { S };
         static constexpr bool c_auto_complete [[maybe_unused]] { C };
         static constexpr unsigned c_default_attempts [[maybe_unused]] { A };
-
-        static_fast_mpmc_queue() noexcept(c_ntdct);
+        static constexpr bool c_stats [[maybe_unused]] { M::c_enabled };
+        static constexpr bool c_trace [[maybe_unused]] { M::c_trace };
+        static constexpr wrap_policy c_wrap_policy [[maybe_unused]] { W };
+        static constexpr queue_lease_policy c_lease_policy [[maybe_unused]] { E };
+        static constexpr unsigned c_max_deliveries [[maybe_unused]] { R };
+        static constexpr bool c_contiguous [[maybe_unused]] {
+            std::is_trivially_copyable_v<T> && E == queue_lease_policy::none
+        };
+        static constexpr bool c_streaming [[maybe_unused]] {
+            std::is_trivially_copyable_v<T> && X == queue_transfer_policy::streaming
+        };
+
+        static_fast_mpmc_queue() noexcept(c_ntdct && std::is_nothrow_default_constructible_v<M>);
         static_fast_mpmc_queue(const static_fast_mpmc_queue &) = delete;
         static_fast_mpmc_queue(static_fast_mpmc_queue &&) = delete;
         ~static_fast_mpmc_queue() = default;
@@ -64,7 +113,7 @@ namespace xtxn {
 
         [[nodiscard, maybe_unused]]
         size_type free_slots() const noexcept {
-            return m_free.load(mo::relaxed);
+            return static_cast<size_type>(m_free.load(mo::relaxed));
         }
 
         [[nodiscard, maybe_unused]]
@@ -83,7 +132,56 @@ namespace xtxn {
         }
 
         [[nodiscard]] producer_accessor producer_slot(unsigned = c_default_attempts) noexcept;
-        [[nodiscard]] consumer_accessor consumer_slot() noexcept;
+        [[nodiscard]] consumer_accessor consumer_slot(unsigned = 0) noexcept;
+
+        /** Claims a run of exactly count consecutive free slots, published together on release **/
+        [[nodiscard, maybe_unused]]
+        producer_span_accessor reserve_contiguous(size_type, unsigned = c_default_attempts) noexcept
+        requires (c_contiguous);
+
+        /** Claims a run of up to count consecutive ready slots, at least one **/
+        [[nodiscard, maybe_unused]]
+        consumer_span_accessor consume_contiguous(size_type, unsigned = 0) noexcept requires (c_contiguous);
+
+        [[nodiscard, maybe_unused]]
+        auto stats() const noexcept requires (M::c_enabled) {
+            return m_stats.snapshot();
+        }
+
+        [[nodiscard, maybe_unused]]
+        auto trace() const requires (M::c_trace) {
+            return m_stats.records();
+        }
+
+        [[maybe_unused]]
+        bool dump_trace(auto && target) const requires (M::c_trace) {
+            return m_stats.dump(target);
+        }
+
+        [[maybe_unused]]
+        void lease_duration(const std::chrono::nanoseconds duration)
+        noexcept requires (E == queue_lease_policy::timeout) {
+            m_lease.duration(duration);
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t reclaimed_leases() const noexcept requires (E == queue_lease_policy::timeout) {
+            return m_lease.reclaimed();
+        }
+
+        /** Sets the sink of items rejected after R deliveries, not to be changed while the queue is in use **/
+        [[maybe_unused]]
+        void dead_letter(std::function<bool(T &)> sink) noexcept requires (R > 0) {
+            m_dead_letter.sink(std::move(sink));
+        }
+
+        [[nodiscard, maybe_unused]]
+        uint64_t dead_letters() const noexcept requires (R > 0) {
+            return m_dead_letter.diverted();
+        }
+
+        /** Takes back the slots of expired leases: prod_locked ones become free, cons_locked ones ready **/
+        [[maybe_unused]] size_type reclaim_expired() noexcept requires (E == queue_lease_policy::timeout);
 
         [[maybe_unused]]
         void shutdown() noexcept {
@@ -97,20 +195,31 @@ namespace xtxn {
         }
     };
 
-    template<std::default_initializable T, signed S, bool C, unsigned A>
-    requires (S > 1) && (A > 0)
-    class static_fast_mpmc_queue<T, S, C, A>::producer_accessor : public slot_completion {
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    class static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::producer_accessor : public slot_completion {
     protected:
         static_fast_mpmc_queue * const m_queue { nullptr };
         offset_type const m_index { c_invalid_index };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+        [[no_unique_address]] ticket m_ticket {};
 
     public:
-        producer_accessor() noexcept = default;
+        producer_accessor() = delete;
+
+        explicit producer_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
         producer_accessor(const producer_accessor &) = delete;
         producer_accessor(producer_accessor &&) = delete;
 
-        producer_accessor(static_fast_mpmc_queue * queue, offset_type index) noexcept
-        : slot_completion {}, m_queue { queue }, m_index { index } {
+        producer_accessor(static_fast_mpmc_queue * queue, offset_type index, const ticket & held) noexcept
+        : slot_completion {}, m_queue { queue }, m_index { index }, m_ticket { held } {
             assert(m_queue);
             assert(m_index < S);
             assert(m_queue->m_state[m_index].load(mo::acquire) == state::prod_locked);
@@ -146,39 +255,77 @@ namespace xtxn {
             );
             return m_queue;
         }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+
+        /** Stores the item with non-temporal stores, bypassing the producer's cache **/
+        [[maybe_unused]]
+        void store(const T & item) noexcept requires (c_streaming) {
+            assert(m_queue);
+            transfer::store(m_queue->m_payload[m_index], item);
+        }
+
+        /** Extends the lease, fails if it has already been reclaimed **/
+        [[maybe_unused]]
+        bool renew() noexcept requires (E == queue_lease_policy::timeout) {
+            assert(m_queue);
+            return m_queue->m_state[m_index].renew(m_ticket, m_queue->m_lease);
+        }
     };
 
-    template<std::default_initializable T, signed S, bool C, unsigned A>
-    requires (S > 1) && (A > 0)
-    static_fast_mpmc_queue<T, S, C, A>::producer_accessor::~producer_accessor() {
-        if (m_queue) {
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::producer_accessor::~producer_accessor() {
+        if (m_queue && m_queue->m_state[m_index].pin(m_ticket)) {
             if constexpr (slot_completion::c_auto_complete) {
-                m_queue->m_state[m_index].store(state::ready, mo::release);
+                m_queue->m_stamps.stamp(m_index);
+                m_queue->m_stats.on_transition(m_index, state::prod_locked, state::ready);
+                m_queue->m_state[m_index].unlock(m_ticket, state::ready);
             } else {
                 if (slot_completion::m_complete) {
-                    m_queue->m_state[m_index].store(state::ready, mo::release);
+                    m_queue->m_stamps.stamp(m_index);
+                    m_queue->m_stats.on_transition(m_index, state::prod_locked, state::ready);
+                    m_queue->m_state[m_index].unlock(m_ticket, state::ready);
                 } else {
-                    m_queue->m_state[m_index].store(state::free, mo::release);
+                    m_queue->m_stats.on_transition(m_index, state::prod_locked, state::free);
+                    m_queue->m_state[m_index].unlock(m_ticket, state::free);
                     m_queue->m_free.fetch_add(1, mo::acq_rel);
                 }
             }
         }
     }
 
-    template<std::default_initializable T, signed S, bool C, unsigned A>
-    requires (S > 1) && (A > 0)
-    class static_fast_mpmc_queue<T, S, C, A>::consumer_accessor : public slot_completion {
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    class static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::consumer_accessor : public slot_completion {
     protected:
         static_fast_mpmc_queue * const m_queue { nullptr };
         offset_type const m_index { c_invalid_index };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+        [[no_unique_address]] ticket m_ticket {};
 
     public:
-        consumer_accessor() noexcept = default;
+        consumer_accessor() = delete;
+
+        explicit consumer_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
         consumer_accessor(const consumer_accessor &) = delete;
         consumer_accessor(consumer_accessor &&) = delete;
 
-        consumer_accessor(static_fast_mpmc_queue * queue, offset_type index) noexcept
-        : slot_completion {}, m_queue { queue }, m_index { index } {
+        consumer_accessor(static_fast_mpmc_queue * queue, offset_type index, const ticket & held) noexcept
+        : slot_completion {}, m_queue { queue }, m_index { index }, m_ticket { held } {
             assert(m_queue);
             assert(m_index < S);
             assert(m_queue->m_state[m_index].load(mo::acquire) == state::cons_locked);
@@ -213,42 +360,242 @@ namespace xtxn {
             );
             return m_queue;
         }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+
+        /** Extends the lease, fails if it has already been reclaimed **/
+        [[maybe_unused]]
+        bool renew() noexcept requires (E == queue_lease_policy::timeout) {
+            assert(m_queue);
+            return m_queue->m_state[m_index].renew(m_ticket, m_queue->m_lease);
+        }
+
+        /** How many times the item has been handed to a consumer, this time included **/
+        [[nodiscard, maybe_unused]]
+        unsigned deliveries() const noexcept requires (R > 0) {
+            assert(m_queue);
+            return m_queue->m_deliveries.count(m_index);
+        }
     };
 
-    template<std::default_initializable T, signed S, bool C, unsigned A>
-    requires (S > 1) && (A > 0)
-    static_fast_mpmc_queue<T, S, C, A>::consumer_accessor::~consumer_accessor() {
-        if (m_queue) {
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::consumer_accessor::~consumer_accessor() {
+        if (m_queue && m_queue->m_state[m_index].pin(m_ticket)) {
             if constexpr (slot_completion::c_auto_complete) {
-                m_queue->m_state[m_index].store(state::free, mo::release);
+                m_queue->m_deliveries.reset(m_index);
+                m_queue->m_stats.on_transition(m_index, state::cons_locked, state::free);
+                m_queue->m_state[m_index].unlock(m_ticket, state::free);
                 m_queue->m_free.fetch_add(1, mo::acq_rel);
             } else {
-                if (slot_completion::m_complete) {
-                    m_queue->m_state[m_index].store(state::free, mo::release);
+                if (
+                    slot_completion::m_complete
+                    || m_queue->m_dead_letter.divert(m_queue->m_payload[m_index], m_queue->m_deliveries.count(m_index))
+                ) {
+                    m_queue->m_deliveries.reset(m_index);
+                    m_queue->m_stats.on_transition(m_index, state::cons_locked, state::free);
+                    m_queue->m_state[m_index].unlock(m_ticket, state::free);
                     m_queue->m_free.fetch_add(1, mo::acq_rel);
                 } else {
-                    m_queue->m_state[m_index].store(state::ready, mo::release);
+                    m_queue->m_stats.on_transition(m_index, state::cons_locked, state::ready);
+                    m_queue->m_state[m_index].unlock(m_ticket, state::ready);
                 }
             }
         }
     }
 
-    template<std::default_initializable T, signed S, bool C, unsigned A>
-    requires (S > 1) && (A > 0)
-    static_fast_mpmc_queue<T, S, C, A>::static_fast_mpmc_queue() noexcept(c_ntdct) {
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    class static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::producer_span_accessor : public slot_completion {
+    protected:
+        static_fast_mpmc_queue * const m_queue { nullptr };
+        size_t const m_first { 0 };
+        size_t const m_count { 0 };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+
+    public:
+        producer_span_accessor() = delete;
+
+        explicit producer_span_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
+        producer_span_accessor(const producer_span_accessor &) = delete;
+        producer_span_accessor(producer_span_accessor &&) = delete;
+
+        producer_span_accessor(static_fast_mpmc_queue * queue, size_t first, size_t count) noexcept
+        : slot_completion {}, m_queue { queue }, m_first { first }, m_count { count } {
+            assert(m_queue);
+            assert(m_count > 0 && m_first + m_count <= S);
+            m_queue->m_free.fetch_sub(static_cast<int_fast32_t>(m_count), mo::acq_rel);
+        }
+
+        ~producer_span_accessor() override;
+
+        producer_span_accessor & operator=(const producer_span_accessor &) = delete;
+        producer_span_accessor & operator=(producer_span_accessor &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        std::span<T> span() noexcept {
+            assert(m_queue);
+            return { &m_queue->m_payload[m_first], m_count };
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() noexcept {
+            return m_queue;
+        }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+    };
+
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::producer_span_accessor::~producer_span_accessor() {
+        if (m_queue) {
+            auto to = state::ready;
+            if constexpr (!slot_completion::c_auto_complete) {
+                if (!slot_completion::m_complete) {
+                    to = state::free;
+                }
+            }
+            for (auto index = m_first; index < m_first + m_count; ++index) {
+                if (to == state::ready) {
+                    m_queue->m_stamps.stamp(index);
+                }
+                m_queue->m_stats.on_transition(index, state::prod_locked, to);
+                m_queue->m_state[index].unlock(ticket {}, to);
+            }
+            if (to == state::free) {
+                m_queue->m_free.fetch_add(static_cast<int_fast32_t>(m_count), mo::acq_rel);
+            }
+        }
+    }
+
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    class static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::consumer_span_accessor : public slot_completion {
+    protected:
+        static_fast_mpmc_queue * const m_queue { nullptr };
+        size_t const m_first { 0 };
+        size_t const m_count { 0 };
+        queue_slot_status const m_status { queue_slot_status::acquired };
+
+    public:
+        consumer_span_accessor() = delete;
+
+        explicit consumer_span_accessor(const queue_slot_status status) noexcept
+        : slot_completion {}, m_status { status } {
+            assert(m_status != queue_slot_status::acquired);
+        }
+
+        consumer_span_accessor(const consumer_span_accessor &) = delete;
+        consumer_span_accessor(consumer_span_accessor &&) = delete;
+
+        consumer_span_accessor(static_fast_mpmc_queue * queue, size_t first, size_t count) noexcept
+        : slot_completion {}, m_queue { queue }, m_first { first }, m_count { count } {
+            assert(m_queue);
+            assert(m_count > 0 && m_first + m_count <= S);
+        }
+
+        ~consumer_span_accessor() override;
+
+        consumer_span_accessor & operator=(const consumer_span_accessor &) = delete;
+        consumer_span_accessor & operator=(consumer_span_accessor &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        std::span<T> span() noexcept {
+            assert(m_queue);
+            return { &m_queue->m_payload[m_first], m_count };
+        }
+
+        [[nodiscard, maybe_unused]]
+        explicit operator bool() noexcept {
+            return m_queue;
+        }
+
+        [[nodiscard, maybe_unused]]
+        queue_slot_status status() const noexcept {
+            return m_status;
+        }
+    };
+
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::consumer_span_accessor::~consumer_span_accessor() {
+        if (m_queue) {
+            int_fast32_t freed { 0 };
+            for (auto index = m_first; index < m_first + m_count; ++index) {
+                auto to = state::free;
+                if constexpr (!slot_completion::c_auto_complete) {
+                    if (
+                        !slot_completion::m_complete
+                        && !m_queue->m_dead_letter.divert(m_queue->m_payload[index], m_queue->m_deliveries.count(index))
+                    ) {
+                        to = state::ready;
+                    }
+                }
+                if (to == state::free) {
+                    m_queue->m_deliveries.reset(index);
+                    ++freed;
+                }
+                m_queue->m_stats.on_transition(index, state::cons_locked, to);
+                m_queue->m_state[index].unlock(ticket {}, to);
+            }
+            if (freed) {
+                m_queue->m_free.fetch_add(freed, mo::acq_rel);
+            }
+        }
+    }
+
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::static_fast_mpmc_queue()
+    noexcept(c_ntdct && std::is_nothrow_default_constructible_v<M>) {
         m_producer.m_enable.test_and_set(mo::acquire);
         m_consumer.m_enable.test_and_set(mo::acquire);
     }
 
-    template<std::default_initializable T, signed S, bool C, unsigned A>
-    requires (S > 1) && (A > 0)
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
     auto
-    static_fast_mpmc_queue<T, S, C, A>::producer_slot(unsigned slot_acquire_attempts)
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::producer_slot(unsigned slot_acquire_attempts)
     noexcept -> producer_accessor {
         assert(slot_acquire_attempts > 0);
 
+        [[maybe_unused]] unsigned probes { 0 };
+
         if (!m_producer.m_enable.test(mo::acquire)) {
-            return {};
+            m_stats.on_acquire(queue_side::producer, queue_slot_status::stopped, probes, S);
+            return producer_accessor { queue_slot_status::stopped };
         }
 
         do {
@@ -257,33 +604,198 @@ namespace xtxn {
                 count && m_producer.m_enable.test(mo::acquire) && m_free.load(mo::acquire);
                 --count
             ) {
-                auto state = state::free;
-                auto index = iterate_post_inc<S>(m_producer.m_index);
-                if (m_state[index].compare_exchange_strong(state, state::prod_locked, mo::acq_rel, mo::acquire)) {
-                    return { this, index };
+                ++probes;
+                ticket held {};
+                auto index = iterate_post_inc<S, W>(m_producer.m_index);
+                if (m_state[index].lock(state::free, state::prod_locked, held, m_lease)) {
+                    m_stats.on_transition(index, state::free, state::prod_locked);
+                    m_stats.on_acquire(queue_side::producer, queue_slot_status::acquired, probes, S);
+                    return { this, index, held };
+                }
+            }
+        } while (--slot_acquire_attempts);
+
+        const auto status = producer_failure();
+        m_stats.on_acquire(queue_side::producer, status, probes, S);
+        return producer_accessor { status };
+    }
+
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    auto
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::consumer_slot(unsigned slot_acquire_attempts)
+    noexcept -> consumer_accessor {
+        [[maybe_unused]] unsigned probes { 0 };
+
+        for (
+            auto budget = slot_acquire_attempts
+                ? static_cast<uint_fast64_t>(slot_acquire_attempts) * static_cast<uint_fast64_t>(S)
+                : std::numeric_limits<uint_fast64_t>::max();
+            budget && m_consumer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) < S;
+            --budget
+        ) {
+            ++probes;
+            ticket held {};
+            auto index = iterate_post_inc<S, W>(m_consumer.m_index);
+            if (m_state[index].lock(state::ready, state::cons_locked, held, m_lease)) {
+                m_stats.on_transition(index, state::ready, state::cons_locked);
+                m_deliveries.deliver(index);
+                m_stats.on_acquire(queue_side::consumer, queue_slot_status::acquired, probes, S);
+                m_stats.on_residence(m_stamps.elapsed(index));
+                transfer::prefetch(m_payload[index + 1 < static_cast<offset_type>(S) ? index + 1 : 0]);
+                return { this, index, held };
+            }
+        }
+
+        const auto status = consumer_failure();
+        m_stats.on_acquire(queue_side::consumer, status, probes, S);
+        return consumer_accessor { status };
+    }
+
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    size_t static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::lock_run(
+        const size_t first, const size_t count, const size_t least, const state from, const state to
+    ) noexcept {
+        size_t locked { 0 };
+        for (ticket held {}; locked < count && m_state[first + locked].lock(from, to, held, m_lease); ++locked) {
+            m_stats.on_transition(first + locked, from, to);
+        }
+        if (locked < least) {
+            for (; locked; --locked) {
+                m_stats.on_transition(first + locked - 1, to, from);
+                m_state[first + locked - 1].unlock(ticket {}, from);
+            }
+        }
+        return locked;
+    }
+
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    auto
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::reserve_contiguous(
+        const size_type count, unsigned slot_acquire_attempts
+    ) noexcept -> producer_span_accessor requires (c_contiguous) {
+        assert(count > 0 && count <= S);
+        assert(slot_acquire_attempts > 0);
+
+        [[maybe_unused]] unsigned probes { 0 };
+
+        if (!m_producer.m_enable.test(mo::acquire)) {
+            m_stats.on_acquire(queue_side::producer, queue_slot_status::stopped, probes, S);
+            return producer_span_accessor { queue_slot_status::stopped };
+        }
+
+        const auto length = static_cast<size_t>(count);
+
+        do {
+            for (
+                auto round = S;
+                round && m_producer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) >= count;
+                --round
+            ) {
+                ++probes;
+                const auto first = static_cast<size_t>(iterate_post_inc<S, W>(m_producer.m_index));
+                if (
+                    first + length <= static_cast<size_t>(S)
+                    && lock_run(first, length, length, state::free, state::prod_locked)
+                ) {
+                    m_producer.m_index.fetch_add(length - 1, mo::relaxed);
+                    m_stats.on_acquire(queue_side::producer, queue_slot_status::acquired, probes, S);
+                    return { this, first, length };
                 }
             }
         } while (--slot_acquire_attempts);
 
-        return {};
+        const auto status = producer_failure();
+        m_stats.on_acquire(queue_side::producer, status, probes, S);
+        return producer_span_accessor { status };
     }
 
-    template<std::default_initializable T, signed S, bool C, unsigned A>
-    requires (S > 1) && (A > 0)
-    auto static_fast_mpmc_queue<T, S, C, A>::consumer_slot() noexcept -> consumer_accessor {
-        while (m_consumer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) < S) {
-            auto state = state::ready;
-            auto index = iterate_post_inc<S>(m_consumer.m_index);
-            if (m_state[index].compare_exchange_strong(state, state::cons_locked, mo::acq_rel, mo::acquire)) {
-                return { this, index };
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    auto
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::consume_contiguous(
+        const size_type count, unsigned slot_acquire_attempts
+    ) noexcept -> consumer_span_accessor requires (c_contiguous) {
+        assert(count > 0 && count <= S);
+
+        [[maybe_unused]] unsigned probes { 0 };
+
+        const auto length = static_cast<size_t>(count);
+
+        for (
+            auto budget = slot_acquire_attempts
+                ? static_cast<uint_fast64_t>(slot_acquire_attempts) * static_cast<uint_fast64_t>(S)
+                : std::numeric_limits<uint_fast64_t>::max();
+            budget && m_consumer.m_enable.test(mo::acquire) && m_free.load(mo::acquire) < S;
+            --budget
+        ) {
+            ++probes;
+            const auto first = static_cast<size_t>(iterate_post_inc<S, W>(m_consumer.m_index));
+            const auto room = static_cast<size_t>(S) - first;
+            const auto locked = lock_run(first, room < length ? room : length, 1, state::ready, state::cons_locked);
+            if (locked) {
+                m_consumer.m_index.fetch_add(locked - 1, mo::relaxed);
+                for (auto index = first; index < first + locked; ++index) {
+                    m_deliveries.deliver(index);
+                    m_stats.on_residence(m_stamps.elapsed(index));
+                }
+                m_stats.on_acquire(queue_side::consumer, queue_slot_status::acquired, probes, S);
+                return { this, first, locked };
+            }
+        }
+
+        const auto status = consumer_failure();
+        m_stats.on_acquire(queue_side::consumer, status, probes, S);
+        return consumer_span_accessor { status };
+    }
+
+    template<
+        std::default_initializable T, signed S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+        queue_lease_policy E, unsigned R, queue_transfer_policy X
+    >
+    requires (S > 1) && (A > 0) && queue_leasable_payload<T, E>
+    auto
+    static_fast_mpmc_queue<T, S, C, A, M, W, E, R, X>::reclaim_expired()
+    noexcept -> size_type requires (E == queue_lease_policy::timeout) {
+        size_type reclaimed { 0 };
+        const auto now = m_lease.now();
+
+        for (offset_type index { 0 }; index < S; ++index) {
+            if (const auto locked = m_state[index].reclaim(now); locked) {
+                if (*locked == state::prod_locked) {
+                    m_stats.on_transition(index, state::prod_locked, state::free);
+                    m_free.fetch_add(1, mo::acq_rel);
+                } else {
+                    m_stats.on_transition(index, state::cons_locked, state::ready);
+                }
+                m_lease.count_reclaimed();
+                ++reclaimed;
             }
         }
 
-        return {};
+        return reclaimed;
     }
 
     template<class T>
     concept any_static_fast_mpmc_queue = requires(T t) {
-        [] <std::default_initializable U, int32_t S, bool C, unsigned A> (static_fast_mpmc_queue<U, S, C, A> &) {} (t);
+        [] <
+            std::default_initializable U, int32_t S, bool C, unsigned A, queue_stats_policy M, wrap_policy W,
+            queue_lease_policy E, unsigned R, queue_transfer_policy X
+        >
+        (static_fast_mpmc_queue<U, S, C, A, M, W, E, R, X> &) {} (t);
     };
 }
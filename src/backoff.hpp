@@ -0,0 +1,71 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#pragma once
+
+#include <xtxn/fast_mpmc_queue_commons.hpp>
+#include <xtxn/spinlock.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace test {
+    /**
+     * Reaction to a failed slot acquisition:
+     * - contended - the slots are about to be released, so the attempt is retried after a short pause, and the thread
+     *   yields once the pauses run out;
+     * - empty - there is nothing to do, so after a few yields the consumer is parked with a timed sleep, which doubles
+     *   up to c_park_max while the queue stays empty;
+     * - full - the consumers are behind, so after a few yields the producer sheds its load by sleeping for
+     *   c_shed_time on every further failure, which leaves the CPU to the consumers;
+     * - stopped - left to the caller's loop condition.
+     * reset() must be called after a successful acquisition, so that the next failure starts over.
+     */
+    class backoff {
+        static constexpr unsigned c_idle_yields { 0x40 };
+        static constexpr std::chrono::microseconds c_park_min { 1 };
+        static constexpr std::chrono::microseconds c_park_max { 0x100 };
+        static constexpr std::chrono::microseconds c_shed_time { 0x10 };
+
+        unsigned m_spins { 0 };
+        unsigned m_idle { 0 };
+        std::chrono::microseconds m_park { c_park_min };
+
+    public:
+        void operator()(const xtxn::queue_slot_status status) noexcept {
+            switch (status) {
+                case xtxn::queue_slot_status::contended:
+                    if (++m_spins < xtxn::spinlock_spin_limit) {
+                        _mm_pause();
+                    } else {
+                        m_spins = 0;
+                        std::this_thread::yield();
+                    }
+                    break;
+                case xtxn::queue_slot_status::empty:
+                    if (++m_idle < c_idle_yields) {
+                        std::this_thread::yield();
+                    } else {
+                        std::this_thread::sleep_for(m_park);
+                        m_park = std::min(m_park * 2, c_park_max);
+                    }
+                    break;
+                case xtxn::queue_slot_status::full:
+                    if (++m_idle < c_idle_yields) {
+                        std::this_thread::yield();
+                    } else {
+                        std::this_thread::sleep_for(c_shed_time);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void reset() noexcept {
+            m_spins = 0;
+            m_idle = 0;
+            m_park = c_park_min;
+        }
+    };
+}
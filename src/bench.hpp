@@ -0,0 +1,365 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Low-overhead queue benchmark. Worker threads keep all counters in their own cache-line aligned probes; besides the
+ * queue they only read the phase flag and publish their progress once per backlog_batch operations. Every N-th
+ * operation is timed with the TSC, from the first attempt to the successful one. Threads run a warm-up phase first;
+ * only the measurement phase is counted, and the per-thread results are merged after the threads have been joined.
+ * Hardware event counters, when enabled, are opened by every thread and run during its measurement phase only.
+ */
+
+#pragma once
+
+#include "messages.hpp"
+#include "types.hpp"
+#include "config.hpp"
+#include "backoff.hpp"
+#include "payload.hpp"
+#include "perf_counters.hpp"
+#include "bench_report.hpp"
+#include <xtxn/latency_histogram.hpp>
+#include <xtxn/fast_mpmc_queue_commons.hpp>
+#include <xtxn/types.hpp>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <latch>
+#include <iostream>
+#include <string_view>
+
+namespace test::bench {
+    using xtxn::queue_slot_status;
+
+#ifdef _DEBUG
+    constexpr std::chrono::milliseconds warmup_time { 10 };
+    constexpr std::chrono::milliseconds measure_time { 20 };
+#else
+    constexpr std::chrono::milliseconds warmup_time { 100 };
+    constexpr std::chrono::milliseconds measure_time { 500 };
+#endif
+    constexpr unsigned sample_period { 0x40 };
+    constexpr int64_t backlog_batch { 0x40 };
+    constexpr int64_t backlog_limit { 0x10'000 };
+
+    enum class phase : uint32_t { warmup, measure, stop };
+
+    using histogram = xtxn::latency_histogram<xtxn::latency_histogram_default_precision, false>;
+
+    /**
+     * Approximate number of queued items. Threads publish their progress once per backlog_batch operations, and
+     * producers pause while the backlog exceeds backlog_limit, so unbounded queues do not grow without limit.
+     */
+    class backlog {
+        struct alignas(xtxn::false_sharing_align) counter {
+            std::atomic_int64_t m_value { 0 };
+        };
+
+        counter m_produced {};
+        counter m_consumed {};
+
+    public:
+        void publish(const bool producer) noexcept {
+            (producer ? m_produced : m_consumed).m_value.fetch_add(backlog_batch, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        bool saturated() const noexcept {
+            return m_produced.m_value.load(std::memory_order_relaxed)
+                - m_consumed.m_value.load(std::memory_order_relaxed) > backlog_limit;
+        }
+    };
+
+    class alignas(xtxn::false_sharing_align) thread_probe {
+        histogram m_latency {};
+        perf_counters m_counters {};
+        uint64_t m_ops { 0 };
+        item_type m_checksum { 0 };
+
+    public:
+        thread_probe() noexcept = default;
+        thread_probe(const thread_probe &) = delete;
+        thread_probe(thread_probe &&) = delete;
+        ~thread_probe() noexcept = default;
+
+        thread_probe & operator=(const thread_probe &) = delete;
+        thread_probe & operator=(thread_probe &&) = delete;
+
+        [[nodiscard]]
+        const histogram & latency() const noexcept {
+            return m_latency;
+        }
+
+        [[nodiscard]]
+        uint64_t ops() const noexcept {
+            return m_ops;
+        }
+
+        [[nodiscard]]
+        const perf_counters & counters() const noexcept {
+            return m_counters;
+        }
+
+        /** Opens the hardware event counters, must be called by the worker thread itself **/
+        void count(const perf_selection & selection) noexcept {
+            m_counters.open(selection);
+        }
+
+        /** Repeats the attempt until the phase becomes 'stop'; the attempt gets the number of the operation **/
+        template<class F>
+        void work(const std::atomic<phase> & current, backlog & queued, const bool producer, F && attempt) noexcept {
+            backoff wait {};
+            unsigned countdown { sample_period };
+            uint64_t started { 0 };
+            bool fresh { true };
+            item_type sequence { 0 };
+            auto now = current.load(std::memory_order_relaxed);
+
+            while (now != phase::stop) {
+                const bool measuring { now == phase::measure };
+                if (fresh) {
+                    fresh = false;
+                    if (measuring && !--countdown) {
+                        countdown = sample_period;
+                        started = xtxn::tsc_now();
+                    }
+                }
+
+                const auto status = attempt(sequence + 1, m_checksum);
+                if (status == queue_slot_status::acquired) {
+                    wait.reset();
+                    fresh = true;
+                    if (measuring) {
+                        ++m_ops;
+                        if (started) {
+                            m_latency.record(xtxn::tsc_now() - started);
+                        }
+                    }
+                    started = 0;
+                    if (!(++sequence % backlog_batch)) {
+                        queued.publish(producer);
+                        while (producer && queued.saturated() && current.load(std::memory_order_relaxed) == now) {
+                            std::this_thread::yield();
+                        }
+                    }
+                } else if (status == queue_slot_status::stopped) {
+                    break;
+                } else {
+                    wait(status);
+                }
+
+                if (const auto next = current.load(std::memory_order_relaxed); next != now) {
+                    if (next == phase::measure) {
+                        m_counters.start();
+                    } else if (now == phase::measure) {
+                        m_counters.stop();
+                    }
+                    now = next;
+                }
+            }
+
+            if (now == phase::measure) {
+                m_counters.stop();
+            }
+        }
+    };
+
+    template<class Q>
+    queue_slot_status produce(Q & queue, const item_type sequence) {
+        using traits = payload<queue_payload_t<Q>>;
+        if constexpr (requires { queue.producer_slot(); }) {
+            auto slot = queue.producer_slot();
+            if (slot) {
+                if constexpr (requires { slot.store(traits::make(sequence)); }) {
+                    slot.store(traits::make(sequence));
+                } else {
+                    *slot = traits::make(sequence);
+                }
+            }
+            return slot.status();
+        } else if constexpr (requires { queue.push(traits::make(sequence)); }) {
+            return queue.push(traits::make(sequence));
+        } else {
+            return queue.enqueue(traits::make(sequence)) ? queue_slot_status::acquired : queue_slot_status::stopped;
+        }
+    }
+
+    /** The value is moved out of a slot, as a consumer that keeps it would do **/
+    template<class Q>
+    queue_slot_status consume(Q & queue, item_type & checksum) {
+        using traits = payload<queue_payload_t<Q>>;
+        if constexpr (requires { queue.consumer_slot(); }) {
+            auto slot = queue.consumer_slot(queue.c_default_attempts);
+            if (slot) {
+                const queue_payload_t<Q> value { std::move(*slot) };
+                checksum += traits::fold(value);
+            }
+            return slot.status();
+        } else if constexpr (requires (queue_payload_t<Q> & value) { queue.pop(value); }) {
+            queue_payload_t<Q> value {};
+            const auto status = queue.pop(value, queue.c_default_attempts);
+            if (status == queue_slot_status::acquired) {
+                checksum += traits::fold(value);
+            }
+            return status;
+        } else {
+            if (auto item = queue.dequeue(); item) {
+                checksum += traits::fold(*item);
+                return queue_slot_status::acquired;
+            }
+            return queue.consuming() ? queue_slot_status::empty : queue_slot_status::stopped;
+        }
+    }
+
+    template<class Q>
+    void leave(Q & queue) {
+        if constexpr (requires { queue.escape(); }) {
+            queue.escape();
+        }
+    }
+
+    template<class Q>
+    result perform(
+        const std::string_view name,
+        const std::string_view params,
+        const config_set & config,
+        const config::placement strategy,
+        const perf_selection & counters = {}
+    ) {
+        auto queue = std::make_unique<Q>();
+        const unsigned threads { config.first + config.second };
+        const auto cpus = config::system_topology().plan(strategy, config);
+        auto probes = std::make_unique<thread_probe[]>(threads);
+        std::vector<std::jthread> pool {};
+        std::latch start { threads + 1 };
+        std::atomic<phase> current { phase::warmup };
+        backlog queued {};
+
+        for (unsigned i { 0 }; i < threads; ++i) {
+            pool.emplace_back(
+                [
+                    & queue = *queue, & probe = probes[i], & start, & current, & queued, & counters,
+                    producer = i < config.first, cpu = cpus[i]
+                ] {
+                    if (cpu) {
+                        config::pin_current_thread(*cpu);
+                    }
+                    probe.count(counters);
+                    start.arrive_and_wait();
+                    if (producer) {
+                        probe.work(current, queued, true, [& queue] (const item_type value, item_type &) {
+                            return produce(queue, value);
+                        });
+                    } else {
+                        probe.work(current, queued, false, [& queue] (const item_type, item_type & checksum) {
+                            return consume(queue, checksum);
+                        });
+                    }
+                    leave(queue);
+                }
+            );
+        }
+
+        start.arrive_and_wait();
+        std::this_thread::sleep_for(warmup_time);
+        current.store(phase::measure, std::memory_order_relaxed);
+        const auto t1 = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(measure_time);
+        current.store(phase::stop, std::memory_order_relaxed);
+        const auto t2 = std::chrono::steady_clock::now();
+        queue->stop();
+        for (auto & thread : pool) {
+            thread.join();
+        }
+
+        histogram enqueue {};
+        histogram dequeue {};
+        perf_totals events {};
+        result summary {};
+        summary.m_queue = name;
+        summary.m_params = params;
+        summary.m_placement = config::name(strategy);
+        summary.m_payload = payload<queue_payload_t<Q>>::name();
+        summary.m_payload_bytes = payload<queue_payload_t<Q>>::bytes(payload<queue_payload_t<Q>>::make(0));
+        summary.m_config = config;
+        summary.m_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+        for (unsigned i { 0 }; i < threads; ++i) {
+            events.add(probes[i].counters());
+            if (i < config.first) {
+                enqueue.merge(probes[i].latency());
+                summary.m_produced += probes[i].ops();
+            } else {
+                dequeue.merge(probes[i].latency());
+                summary.m_consumed += probes[i].ops();
+            }
+        }
+        const double scale { 1.0 / xtxn::tsc_ticks_per_ns() };
+        summary.m_enqueue = enqueue.summary(scale);
+        summary.m_dequeue = dequeue.summary(scale);
+        summary.m_counters = events.per_op(summary.m_consumed);
+        return summary;
+    }
+
+    inline void print_header() {
+        std::cout
+            << thick_separator
+            << "   QUEUE                                |  P/C  |  MOP/S  |  NS/OP  "
+            << "| ENQ P50/P99/P99.9 NS | DEQ P50/P99/P99.9 NS\n"
+            << thin_separator;
+    }
+
+    /** Prints the hardware events per operation on a line of their own, nothing if none was counted **/
+    inline void print_counters(const result & summary) {
+        constexpr std::string_view labels[] { "cycles", "instr.", "L1D miss", "LLC miss", "br. miss", "coherence" };
+        if (std::ranges::none_of(summary.m_counters, [] (const auto & value) { return value.has_value(); })) {
+            return;
+        }
+        std::cout << std::fixed << std::setprecision(2) << "     per op:";
+        for (size_t i { 0 }; i < perf_event_count; ++i) {
+            if (summary.m_counters[i]) {
+                std::cout << ' ' << labels[i] << ' ' << *summary.m_counters[i] << ';';
+            }
+        }
+        std::cout << '\n';
+    }
+
+    inline void print(const result & summary) {
+        const auto percentiles = [] (std::ostream & stream, const xtxn::latency_summary & latency) -> std::ostream & {
+            return stream
+                << std::setw(6) << latency.m_p50 << '/' << std::setw(6) << latency.m_p99 << '/'
+                << std::setw(7) << latency.m_p999;
+        };
+
+        std::cout
+            << std::fixed << std::setprecision(2)
+            << "   " << std::setw(36) << std::left << (summary.m_queue + ' ' + summary.m_params) << std::right << " | "
+            << std::setw(2) << summary.m_config.first << '/' << std::setw(2) << summary.m_config.second << " | "
+            << std::setw(7) << summary.ops_per_second() / 1e6 << " | "
+            << std::setw(7) << summary.ns_per_op() << " | ";
+        percentiles(std::cout, summary.m_enqueue) << " | ";
+        percentiles(std::cout, summary.m_dequeue) << '\n';
+        print_counters(summary);
+    }
+
+    template<class Q>
+    void perform(
+        report & output,
+        const std::string_view name,
+        const std::string_view params,
+        std::initializer_list<config_set> configs
+    ) {
+        for (const auto & config : configs) {
+            for (unsigned run { 0 }; run < output.runs(); ++run) {
+                auto summary = perform<Q>(name, params, config, output.placement(), output.counters());
+                summary.m_run = run;
+                print(summary);
+                output.add(std::move(summary));
+            }
+        }
+        std::cout << thin_separator;
+    }
+}
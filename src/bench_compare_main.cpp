@@ -0,0 +1,180 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Compares two benchmark result files (CSV or JSON) configuration by configuration. Throughput and dequeue p99 are
+ * compared with Welch's t-test over the runs; a change is flagged as a regression when it is worse than the threshold
+ * and significant at the 95% level (with a single run on either side only the threshold is applied). The exit code is
+ * non-zero if any regression has been found.
+ *
+ * Usage: bench_compare BASELINE CANDIDATE [--threshold=PERCENT]
+ */
+
+#include "init.hpp"
+#include "messages.hpp"
+#include "bench_report.hpp"
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test::bench {
+    constexpr double default_threshold { 5.0 };
+
+    /** Two-sided 95% critical values of Student's t distribution for 1..30 degrees of freedom **/
+    constexpr double t_critical[] {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+
+    struct sample {
+        double m_mean { 0.0 };
+        double m_variance { 0.0 };
+        size_t m_count { 0 };
+
+        explicit sample(const std::vector<double> & values) {
+            m_count = values.size();
+            if (!m_count) {
+                return;
+            }
+            for (const double value : values) {
+                m_mean += value;
+            }
+            m_mean /= static_cast<double>(m_count);
+            if (m_count > 1) {
+                for (const double value : values) {
+                    m_variance += (value - m_mean) * (value - m_mean);
+                }
+                m_variance /= static_cast<double>(m_count - 1);
+            }
+        }
+    };
+
+    bool significant(const sample & a, const sample & b) {
+        if (a.m_count < 2 || b.m_count < 2) {
+            return true;
+        }
+        const double va { a.m_variance / static_cast<double>(a.m_count) };
+        const double vb { b.m_variance / static_cast<double>(b.m_count) };
+        if (va + vb <= 0.0) {
+            return a.m_mean < b.m_mean || b.m_mean < a.m_mean;
+        }
+        const double t { std::abs(a.m_mean - b.m_mean) / std::sqrt(va + vb) };
+        const double df {
+            (va + vb) * (va + vb)
+            / (va * va / static_cast<double>(a.m_count - 1) + vb * vb / static_cast<double>(b.m_count - 1))
+        };
+        const auto index = static_cast<size_t>(std::max(1.0, std::floor(df))) - 1;
+        return t > (index < std::size(t_critical) ? t_critical[index] : 1.96);
+    }
+
+    using grouped = std::map<std::string, std::vector<const result *>>;
+
+    grouped group(const std::vector<result> & results) {
+        grouped groups {};
+        for (const auto & record : results) {
+            groups[record.key()].push_back(&record);
+        }
+        return groups;
+    }
+
+    template<class F>
+    std::vector<double> extract(const std::vector<const result *> & records, F && metric) {
+        std::vector<double> values {};
+        values.reserve(records.size());
+        for (const auto * record : records) {
+            values.push_back(metric(*record));
+        }
+        return values;
+    }
+
+    std::vector<result> load(const std::string_view path) {
+        std::ifstream file { std::string { path } };
+        if (!file) {
+            std::cerr << "Can't open " << path << '\n';
+            std::exit(EXIT_FAILURE);
+        }
+        return read_results(file);
+    }
+}
+
+int main(int argc, char ** argv) {
+    using namespace test::bench;
+
+    init::console();
+
+    double threshold { default_threshold };
+    std::vector<std::string_view> paths {};
+    for (int i { 1 }; i < argc; ++i) {
+        const std::string_view arg { argv[i] };
+        if (arg.starts_with("--threshold=")) {
+            threshold = std::strtod(arg.data() + 12, nullptr);
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2) {
+        std::cerr << "Usage: " << argv[0] << " BASELINE CANDIDATE [--threshold=PERCENT]\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto baseline = load(paths[0]);
+    const auto candidate = load(paths[1]);
+    const auto baseline_groups = group(baseline);
+    const auto candidate_groups = group(candidate);
+
+    const auto throughput = [] (const result & record) { return record.ops_per_second(); };
+    const auto dequeue_p99 = [] (const result & record) { return static_cast<double>(record.m_dequeue.m_p99); };
+
+    std::cout
+        << thick_separator
+        << "   CONFIGURATION                        |  MOP/S OLD -> NEW    |  CHANGE | DEQ P99 OLD -> NEW | VERDICT\n"
+        << thin_separator;
+
+    unsigned regressions { 0 };
+    for (const auto & [key, records] : candidate_groups) {
+        const auto it = baseline_groups.find(key);
+        if (it == baseline_groups.end()) {
+            std::cout << "   " << std::setw(38) << std::left << key << std::right << " | (no baseline)\n";
+            continue;
+        }
+
+        const sample old_ops { extract(it->second, throughput) };
+        const sample new_ops { extract(records, throughput) };
+        const sample old_p99 { extract(it->second, dequeue_p99) };
+        const sample new_p99 { extract(records, dequeue_p99) };
+
+        const double change {
+            old_ops.m_mean > 0.0 ? (new_ops.m_mean - old_ops.m_mean) * 100.0 / old_ops.m_mean : 0.0
+        };
+        const double p99_change {
+            old_p99.m_mean > 0.0 ? (new_p99.m_mean - old_p99.m_mean) * 100.0 / old_p99.m_mean : 0.0
+        };
+        const bool slower { -change > threshold && significant(old_ops, new_ops) };
+        const bool laggier { p99_change > threshold && significant(old_p99, new_p99) };
+        regressions += slower || laggier ? 1 : 0;
+
+        std::cout
+            << std::fixed << std::setprecision(2)
+            << "   " << std::setw(38) << std::left << key << std::right << " | "
+            << std::setw(8) << old_ops.m_mean / 1e6 << " -> " << std::setw(8) << new_ops.m_mean / 1e6 << " | "
+            << std::setw(6) << change << "% | "
+            << std::setw(7) << static_cast<uint64_t>(old_p99.m_mean) << " -> "
+            << std::setw(7) << static_cast<uint64_t>(new_p99.m_mean) << " | "
+            << (slower ? "SLOWER " : "") << (laggier ? "P99 " : "") << (slower || laggier ? "REGRESSION" : "ok")
+            << '\n';
+    }
+
+    std::cout
+        << thick_separator
+        << "   Regressions (threshold " << threshold << "%): " << regressions << '\n'
+        << thick_separator;
+
+    return regressions ? EXIT_FAILURE : EXIT_SUCCESS;
+}
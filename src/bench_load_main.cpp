@@ -0,0 +1,328 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Open-loop load generator. Producers issue items on a schedule (fixed intervals or Poisson arrivals) that does not
+ * depend on the queue: an item that could not be enqueued in time is sent as soon as possible, but the following items
+ * keep their intended times. Every item carries its intended send time, and the consumers record the latency from that
+ * time, so queue-full stalls are charged to every item they delay (no coordinated omission). The offered load is swept
+ * to find the saturation knee of each queue: the first rate at which the achieved throughput falls below 95% of the
+ * offered one or the p99 latency exceeds ten times the p99 at the lowest rate. The consumers poll an empty queue with
+ * pauses instead of the backoff, which would park them, so that the latency below the knee is the queue's own; only a
+ * consumer which isn't pinned yields after spinlock_spin_limit pauses.
+ *
+ * Usage: bench_load [--rates=LIST] [--poisson] [--producers=N] [--consumers=N] [--runs=N] [--placement=STRATEGY]
+ *     [--csv=FILE] [--json=FILE]
+ * Rates are total items per second, e.g. --rates=100000,1000000,4000000. Every offered rate is a separate record of
+ * the report (with the rate among the parameters) and its latency from the intended send time is the dequeue latency.
+ */
+
+#include "init.hpp"
+#include "config.hpp"
+#include "bench.hpp"
+#include <xtxn/latency_histogram.hpp>
+#include <xtxn/mpmc_queue.hpp>
+#include <xtxn/mpmcdd_queue.hpp>
+#include <xtxn/mpmcsl_queue.hpp>
+#include <xtxn/mpmchp_queue.hpp>
+#include <xtxn/mpmctl_queue.hpp>
+#include <xtxn/static_fast_mpmc_queue.hpp>
+#include <xtxn/dynamic_fast_mpmc_queue.hpp>
+#include <cstdlib>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <latch>
+#include <iostream>
+
+namespace test::bench {
+    constexpr double knee_throughput { 0.95 };
+    constexpr uint64_t knee_latency_factor { 10 };
+    constexpr uint64_t schedule_spin_ns { 2'000 };
+
+    struct load_options {
+        static constexpr std::string_view usage { "[--rates=LIST] [--poisson] [--producers=N] [--consumers=N]" };
+
+        std::vector<double> m_rates { 1e5, 2.5e5, 5e5, 1e6, 2e6, 4e6, 8e6 };
+        bool m_poisson { false };
+        config_set m_config { config::mpmc::same(std::max(1u, config::baseline_concurrency() >> 1)) };
+        config::placement m_placement { config::placement::none };
+
+        /** Recognizes the options of the benchmark, the rest of the command line belongs to the report **/
+        static bool accepts(const std::string_view arg) {
+            return (arg.starts_with("--rates=") && arg.size() > 8) || arg == "--poisson"
+                || arg.starts_with("--producers=") || arg.starts_with("--consumers=")
+                || (arg.starts_with("--placement=") && config::parse_placement(arg.substr(12)));
+        }
+
+        load_options(const int argc, char ** argv) {
+            for (int i { 1 }; i < argc; ++i) {
+                const std::string_view arg { argv[i] };
+                if (arg.starts_with("--rates=") && arg.size() > 8) {
+                    m_rates.clear();
+                    for (const char * pos { arg.data() + 8 }; *pos;) {
+                        char * end { nullptr };
+                        if (const auto rate = std::strtod(pos, &end); rate > 0.0) {
+                            m_rates.push_back(rate);
+                        }
+                        pos = *end == ',' ? end + 1 : end + (*end ? 1 : 0);
+                    }
+                } else if (arg == "--poisson") {
+                    m_poisson = true;
+                } else if (arg.starts_with("--producers=")) {
+                    m_config.first = std::max(1u, static_cast<unsigned>(std::strtoul(arg.data() + 12, nullptr, 10)));
+                } else if (arg.starts_with("--consumers=")) {
+                    m_config.second = std::max(1u, static_cast<unsigned>(std::strtoul(arg.data() + 12, nullptr, 10)));
+                } else if (arg.starts_with("--placement=") && config::parse_placement(arg.substr(12))) {
+                    m_placement = *config::parse_placement(arg.substr(12));
+                }
+            }
+            if (m_rates.empty()) {
+                m_rates.push_back(1e6);
+            }
+        }
+    };
+
+    struct load_point {
+        double m_offered { 0.0 };
+        double m_achieved { 0.0 };
+        xtxn::latency_summary m_latency {};
+        int64_t m_duration { 0 }; /** nanoseconds **/
+    };
+
+    struct alignas(xtxn::false_sharing_align) consumer_probe {
+        histogram m_latency {};
+        uint64_t m_count { 0 };
+    };
+
+    /** Intended send times of one producer, in TSC ticks **/
+    class schedule {
+        std::mt19937_64 m_random;
+        std::exponential_distribution<double> m_gap;
+        double m_interval;
+        double m_next;
+        bool m_poisson;
+
+    public:
+        schedule(const uint64_t start, const double interval, const bool poisson, const unsigned seed)
+        : m_random { seed }, m_gap { 1.0 / interval }, m_interval { interval },
+          m_next { static_cast<double>(start) }, m_poisson { poisson } {}
+
+        uint64_t next() noexcept {
+            m_next += m_poisson ? m_gap(m_random) : m_interval;
+            return static_cast<uint64_t>(m_next);
+        }
+    };
+
+    template<class Q>
+    load_point offer(const double rate, const load_options & options) {
+        auto queue = std::make_unique<Q>();
+        const auto & config = options.m_config;
+        const unsigned threads { config.first + config.second };
+        const auto cpus = config::system_topology().plan(options.m_placement, config);
+        const double ticks_per_ns { xtxn::tsc_ticks_per_ns() };
+        const double interval { ticks_per_ns * 1e9 * static_cast<double>(config.first) / rate };
+        const auto spin_ticks = static_cast<uint64_t>(ticks_per_ns * static_cast<double>(schedule_spin_ns));
+        auto probes = std::make_unique<consumer_probe[]>(config.second);
+        std::vector<std::jthread> pool {};
+        std::latch start { threads + 1 };
+        std::atomic<phase> current { phase::warmup };
+        std::atomic_uint64_t origin { 0 };
+
+        for (unsigned i { 0 }; i < config.first; ++i) {
+            pool.emplace_back(
+                [& queue = *queue, & start, & current, & origin, & options, interval, spin_ticks, cpu = cpus[i], i] {
+                    if (cpu) {
+                        config::pin_current_thread(*cpu);
+                    }
+                    start.arrive_and_wait();
+                    schedule plan { origin.load(std::memory_order_acquire), interval, options.m_poisson, i + 1 };
+                    backoff wait {};
+                    for (auto intended = plan.next(); current.load(std::memory_order_relaxed) != phase::stop;) {
+                        if (const auto now = xtxn::tsc_now(); now < intended) {
+                            if (intended - now > spin_ticks) {
+                                std::this_thread::yield();
+                            } else {
+                                _mm_pause();
+                            }
+                            continue;
+                        }
+                        const auto status = produce(queue, static_cast<item_type>(intended));
+                        if (status == queue_slot_status::acquired) {
+                            wait.reset();
+                            intended = plan.next();
+                        } else if (status == queue_slot_status::stopped) {
+                            break;
+                        } else {
+                            wait(status);
+                        }
+                    }
+                    leave(queue);
+                }
+            );
+        }
+
+        for (unsigned i { 0 }; i < config.second; ++i) {
+            pool.emplace_back(
+                [& queue = *queue, & probe = probes[i], & start, & current, cpu = cpus[config.first + i]] {
+                    const bool pinned { cpu && config::pin_current_thread(*cpu) };
+                    start.arrive_and_wait();
+                    for (unsigned spins { 0 };;) {
+                        item_type intended { 0 };
+                        const auto status = consume(queue, intended);
+                        if (status == queue_slot_status::acquired) {
+                            spins = 0;
+                            if (current.load(std::memory_order_relaxed) == phase::measure) {
+                                const auto now = xtxn::tsc_now();
+                                const auto sent = static_cast<uint64_t>(intended);
+                                probe.m_latency.record(now > sent ? now - sent : 0);
+                                ++probe.m_count;
+                            }
+                        } else if (status == queue_slot_status::stopped) {
+                            break;
+                        } else if (!pinned && ++spins >= xtxn::spinlock_spin_limit) {
+                            spins = 0;
+                            std::this_thread::yield();
+                        } else {
+                            _mm_pause();
+                        }
+                    }
+                    leave(queue);
+                }
+            );
+        }
+
+        origin.store(xtxn::tsc_now(), std::memory_order_release);
+        start.arrive_and_wait();
+        std::this_thread::sleep_for(warmup_time);
+        current.store(phase::measure, std::memory_order_relaxed);
+        const auto t1 = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(measure_time);
+        current.store(phase::stop, std::memory_order_relaxed);
+        const auto t2 = std::chrono::steady_clock::now();
+        queue->stop();
+        for (auto & thread : pool) {
+            thread.join();
+        }
+
+        histogram latency {};
+        uint64_t total { 0 };
+        for (unsigned i { 0 }; i < config.second; ++i) {
+            latency.merge(probes[i].m_latency);
+            total += probes[i].m_count;
+        }
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+        return {
+            rate,
+            ns ? static_cast<double>(total) * 1e9 / static_cast<double>(ns) : 0.0,
+            latency.summary(1.0 / ticks_per_ns),
+            ns
+        };
+    }
+
+    template<class Q>
+    void sweep(
+        report & output,
+        const std::string_view name,
+        const std::string_view params,
+        const load_options & options,
+        const unsigned run
+    ) {
+        std::optional<double> knee {};
+        uint64_t base_p99 { 0 };
+        for (const double rate : options.m_rates) {
+            const auto point = offer<Q>(rate, options);
+            result record {};
+            record.m_queue = name;
+            record.m_params = std::string { params } + (params.empty() ? "" : " ") + "rate="
+                + std::to_string(static_cast<uint64_t>(rate)) + (options.m_poisson ? " poisson" : "");
+            record.m_placement = config::name(options.m_placement);
+            record.m_config = options.m_config;
+            record.m_run = run;
+            record.m_duration = point.m_duration;
+            record.m_consumed = point.m_latency.m_count;
+            record.m_dequeue = point.m_latency;
+            output.add(std::move(record));
+
+            if (!base_p99) {
+                base_p99 = std::max<uint64_t>(point.m_latency.m_p99, 1);
+            }
+            const bool saturated {
+                point.m_achieved < point.m_offered * knee_throughput
+                || point.m_latency.m_p99 > base_p99 * knee_latency_factor
+            };
+            if (saturated && !knee) {
+                knee = rate;
+            }
+            std::cout
+                << std::fixed << std::setprecision(2)
+                << "   " << std::setw(30) << std::left << (std::string { name } + ' ' + std::string { params })
+                << std::right << " | " << std::setw(8) << point.m_offered / 1e6 << " | "
+                << std::setw(8) << point.m_achieved / 1e6 << " | "
+                << std::setw(9) << point.m_latency.m_p50 << '/' << std::setw(10) << point.m_latency.m_p99 << '/'
+                << std::setw(10) << point.m_latency.m_p999 << '/' << std::setw(10) << point.m_latency.m_max
+                << (saturated ? " *" : "") << '\n';
+        }
+        std::cout << "   Saturation knee: ";
+        if (knee) {
+            std::cout << std::fixed << std::setprecision(2) << *knee / 1e6 << " MOP/S\n";
+        } else {
+            std::cout << "not reached\n";
+        }
+        std::cout << thin_separator;
+    }
+
+    template<class Q>
+    void sweep(
+        report & output,
+        const std::string_view name,
+        const std::string_view params,
+        const load_options & options
+    ) {
+        for (unsigned run { 0 }; run < output.runs(); ++run) {
+            sweep<Q>(output, name, params, options, run);
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+    using namespace xtxn;
+    using test::item_type;
+    using test::bench::sweep;
+    using test::bench::load_options;
+
+    init::console();
+    init::profiler();
+
+    test::bench::report report { argc, argv, &load_options::accepts, load_options::usage };
+    const load_options options { argc, argv };
+
+    std::cout
+        << thick_separator
+        << "   Arrivals: " << (options.m_poisson ? "Poisson" : "fixed rate") << ", P/C: " << options.m_config.first
+        << '/' << options.m_config.second << ", placement: " << test::config::name(options.m_placement) << '\n'
+        << thick_separator
+        << "   QUEUE                          | OFFERED  | ACHIEVED | LATENCY P50/P99/P99.9/MAX NS (* SATURATED)\n"
+        << "                                  |  MOP/S   |  MOP/S   |\n"
+        << thin_separator;
+
+    sweep<mpmc_queue<item_type>>(report, "mpmc", "", options);
+    sweep<mpmcdd_queue<item_type, queue_purge_policy::deletions>>(report, "mpmcdd", "P=deletions", options);
+    sweep<mpmcsl_queue<item_type>>(report, "mpmcsl", "", options);
+    sweep<mpmchp_queue<item_type>>(report, "mpmchp", "", options);
+    sweep<mpmctl_queue<item_type>>(report, "mpmctl", "", options);
+    sweep<static_fast_mpmc_queue<item_type, 100, true, 10>>(report, "static_fast", "S=100 A=10", options);
+    sweep<static_fast_mpmc_queue<item_type, 1'000, true, 10>>(report, "static_fast", "S=1000 A=10", options);
+    sweep<dynamic_fast_mpmc_queue<item_type, 100, 10, true, 10>>(report, "dynamic_fast", "S=100 L=10 A=10", options);
+    sweep<dynamic_fast_mpmc_queue<item_type, 1'000, 10, true, 10>>(report, "dynamic_fast", "S=1000 L=10 A=10", options);
+
+    std::cout << thick_separator;
+    return report.save() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Policy matrix of the fast queues: the dynamic queue is measured for every cursor policy, growth policy and number
+ * of acquire attempts, the static queue for every wrap policy and number of acquire attempts, so the fastest
+ * combination for the host can be picked. Accepts the common options: --runs, --placement, --csv, --json.
+ */
+
+#include "init.hpp"
+#include "config.hpp"
+#include "bench.hpp"
+#include <xtxn/static_fast_mpmc_queue.hpp>
+#include <xtxn/dynamic_fast_mpmc_queue.hpp>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <iostream>
+
+namespace test::bench {
+    using xtxn::queue_cursor_policy;
+    using xtxn::queue_growth_policy;
+    using xtxn::wrap_policy;
+
+    constexpr int matrix_block_size { 100 };
+    constexpr int matrix_max_blocks { 10 };
+    constexpr int matrix_static_size { 1'000 };
+
+    inline std::string_view name(const queue_cursor_policy policy) {
+        constexpr std::string_view names[] { "exchange", "store", "cas" };
+        return names[static_cast<size_t>(policy)];
+    }
+
+    inline std::string_view name(const queue_growth_policy policy) {
+        constexpr std::string_view names[] { "call", "round", "step" };
+        return names[static_cast<size_t>(policy)];
+    }
+
+    inline std::string_view name(const wrap_policy policy) {
+        constexpr std::string_view names[] { "modulo", "reduce", "subtract" };
+        return names[static_cast<size_t>(policy)];
+    }
+
+    template<queue_cursor_policy K, queue_growth_policy G, unsigned A>
+    void dynamic_cell(report & output, const std::initializer_list<config_set> configs) {
+        using queue = xtxn::dynamic_fast_mpmc_queue<
+            item_type, matrix_block_size, matrix_max_blocks, true, A, G, xtxn::queue_no_stats, K
+        >;
+        const auto params = "K=" + std::string { name(K) } + " G=" + std::string { name(G) } + " A="
+            + std::to_string(A);
+        perform<queue>(output, "dynamic_fast", params, configs);
+    }
+
+    template<wrap_policy W, unsigned A>
+    void static_cell(report & output, const std::initializer_list<config_set> configs) {
+        using queue = xtxn::static_fast_mpmc_queue<item_type, matrix_static_size, true, A, xtxn::queue_no_stats, W>;
+        const auto params = "W=" + std::string { name(W) } + " A=" + std::to_string(A);
+        perform<queue>(output, "static_fast", params, configs);
+    }
+
+    template<unsigned... A>
+    void dynamic_matrix(report & output, const std::initializer_list<config_set> configs) {
+        const auto row = [& output, configs] <queue_cursor_policy K, queue_growth_policy G> () {
+            (dynamic_cell<K, G, A>(output, configs), ...);
+        };
+        const auto plane = [& row] <queue_cursor_policy K> () {
+            row.template operator()<K, queue_growth_policy::call>();
+            row.template operator()<K, queue_growth_policy::round>();
+            row.template operator()<K, queue_growth_policy::step>();
+        };
+        plane.template operator()<queue_cursor_policy::exchange>();
+        plane.template operator()<queue_cursor_policy::store>();
+        plane.template operator()<queue_cursor_policy::cas>();
+    }
+
+    template<unsigned... A>
+    void static_matrix(report & output, const std::initializer_list<config_set> configs) {
+        const auto row = [& output, configs] <wrap_policy W> () {
+            (static_cell<W, A>(output, configs), ...);
+        };
+        row.template operator()<wrap_policy::modulo>();
+        row.template operator()<wrap_policy::reduce>();
+        row.template operator()<wrap_policy::subtract>();
+    }
+}
+
+int main(int argc, char ** argv) {
+    using namespace test::bench;
+
+    init::console();
+    init::profiler();
+
+    report output { argc, argv };
+    const auto config = test::config::mpmc::same(test::config::baseline_concurrency());
+
+    print_header();
+
+    dynamic_matrix<1, 4, 16>(output, { config });
+    static_matrix<1, 4, 16>(output, { config });
+
+    std::cout << thick_separator;
+    return output.save() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Payload-size sweep: every MPMC queue is measured with fixed-size payloads from 8 bytes to 4 KB and with heap-owning
+ * std::string and std::vector payloads, with as many producers and consumers as there are available CPUs.
+ */
+
+#include "init.hpp"
+#include "config.hpp"
+#include "bench.hpp"
+#include "payload.hpp"
+#include <xtxn/mpmc_queue.hpp>
+#include <xtxn/mpmcdd_queue.hpp>
+#include <xtxn/mpmcsl_queue.hpp>
+#include <xtxn/mpmchp_queue.hpp>
+#include <xtxn/mpmctl_queue.hpp>
+#include <xtxn/static_fast_mpmc_queue.hpp>
+#include <xtxn/dynamic_fast_mpmc_queue.hpp>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+
+namespace test::bench {
+    template<typename T> using mpmc = xtxn::mpmc_queue<T>;
+    template<typename T> using mpmcdd = xtxn::mpmcdd_queue<T, xtxn::queue_purge_policy::deletions>;
+    template<typename T> using mpmcsl = xtxn::mpmcsl_queue<T>;
+    template<typename T> using mpmchp = xtxn::mpmchp_queue<T>;
+    template<typename T> using mpmctl = xtxn::mpmctl_queue<T>;
+    template<typename T> using static_fast = xtxn::static_fast_mpmc_queue<T, 1'000, true, 10>;
+    template<typename T> using static_fast_nt = xtxn::static_fast_mpmc_queue<
+        T, 1'000, true, 10, xtxn::queue_no_stats, xtxn::wrap_policy::subtract, xtxn::queue_lease_policy::none,
+        xtxn::queue_unlimited_deliveries, xtxn::queue_transfer_policy::streaming
+    >;
+    template<typename T> using dynamic_fast = xtxn::dynamic_fast_mpmc_queue<T, 100, 10, true, 10>;
+
+    inline void print_sweep_header() {
+        std::cout
+            << thick_separator
+            << "   QUEUE           | PAYLOAD |  P/C  |  MOP/S  |   MB/S   |  NS/OP  | DEQ P50/P99/P99.9 NS\n"
+            << thin_separator;
+    }
+
+    inline void print_sweep(const result & summary) {
+        std::cout
+            << std::fixed << std::setprecision(2)
+            << "   " << std::setw(15) << std::left << summary.m_queue << std::right << " | "
+            << std::setw(7) << summary.m_payload << " | "
+            << std::setw(2) << summary.m_config.first << '/' << std::setw(2) << summary.m_config.second << " | "
+            << std::setw(7) << summary.ops_per_second() / 1e6 << " | "
+            << std::setw(8) << summary.bytes_per_second() / 1e6 << " | "
+            << std::setw(7) << summary.ns_per_op() << " | "
+            << std::setw(6) << summary.m_dequeue.m_p50 << '/' << std::setw(6) << summary.m_dequeue.m_p99 << '/'
+            << std::setw(7) << summary.m_dequeue.m_p999 << '\n';
+        print_counters(summary);
+    }
+
+    template<template<typename> class Q, typename... V>
+    void sweep(report & output, const std::string_view name, const std::string_view params, const config_set & config) {
+        const auto measure = [& output, name, params, & config] <typename P> () {
+            for (unsigned run { 0 }; run < output.runs(); ++run) {
+                auto summary = perform<Q<P>>(name, params, config, output.placement(), output.counters());
+                summary.m_run = run;
+                print_sweep(summary);
+                output.add(std::move(summary));
+            }
+        };
+        (measure.template operator()<V>(), ...);
+        std::cout << thin_separator;
+    }
+
+    template<template<typename> class Q>
+    void sweep_all(
+        report & output,
+        const std::string_view name,
+        const std::string_view params,
+        const config_set & config
+    ) {
+        sweep<
+            Q, item_type, blob<16>, blob<32>, blob<64>, blob<128>, blob<256>, blob<512>, blob<1'024>, blob<2'048>,
+            blob<4'096>, std::string, std::vector<item_type>
+        >(output, name, params, config);
+    }
+}
+
+int main(int argc, char ** argv) {
+    using namespace test::bench;
+
+    init::console();
+    init::profiler();
+
+    report output { argc, argv };
+    const auto config = test::config::mpmc::same(test::config::baseline_concurrency());
+
+    print_sweep_header();
+
+    sweep_all<mpmc>(output, "mpmc", "", config);
+    sweep_all<mpmcdd>(output, "mpmcdd", "P=deletions", config);
+    sweep_all<mpmcsl>(output, "mpmcsl", "", config);
+    sweep_all<mpmchp>(output, "mpmchp", "", config);
+    sweep_all<mpmctl>(output, "mpmctl", "", config);
+    sweep_all<static_fast>(output, "static_fast", "S=1000 A=10", config);
+    sweep_all<static_fast_nt>(output, "static_fast_nt", "S=1000 A=10 X=streaming", config);
+    sweep_all<dynamic_fast>(output, "dynamic_fast", "S=100 L=10 A=10", config);
+
+    std::cout << thick_separator;
+    return output.save() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,263 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Round-trip latency benchmark. Every pair of threads owns two queues: the initiator sends a token through the first
+ * one and waits for the responder to return it through the second one, so each round trip is two one-way handoffs of
+ * a single item. Only the initiator measures, from sending the token to receiving the reply.
+ *
+ * Usage: bench_pingpong [--pairs=N] [--cpus=LIST] [--runs=N] [--placement=STRATEGY] [--csv=FILE] [--json=FILE]
+ * The initiators are placed as producers and the responders as consumers; an explicit comma-separated CPU list is
+ * consumed in the order "initiator 0, responder 0, initiator 1, ..." and overrides the placement strategy.
+ * In the result records the round trips are the consumed items and the round-trip time is the dequeue latency, so
+ * bench_compare gates on both.
+ */
+
+#include "init.hpp"
+#include "config.hpp"
+#include "bench.hpp"
+#include <xtxn/latency_histogram.hpp>
+#include <xtxn/mpsc_queue.hpp>
+#include <xtxn/mpmc_queue.hpp>
+#include <xtxn/mpmcdd_queue.hpp>
+#include <xtxn/mpmcsl_queue.hpp>
+#include <xtxn/mpmchp_queue.hpp>
+#include <xtxn/mpmctl_queue.hpp>
+#include <xtxn/static_fast_mpmc_queue.hpp>
+#include <xtxn/dynamic_fast_mpmc_queue.hpp>
+#include <cstdlib>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <latch>
+#include <iostream>
+
+namespace test::bench {
+    struct pingpong_options {
+        static constexpr std::string_view usage { "[--pairs=N] [--cpus=LIST]" };
+
+        unsigned m_pairs { 1 };
+        config::placement m_placement { config::placement::none };
+        std::vector<unsigned> m_cpus {};
+
+        /** Recognizes the options of the benchmark, the rest of the command line belongs to the report **/
+        static bool accepts(const std::string_view arg) {
+            return arg.starts_with("--pairs=") || (arg.starts_with("--cpus=") && arg.size() > 7)
+                || (arg.starts_with("--placement=") && config::parse_placement(arg.substr(12)));
+        }
+
+        pingpong_options(const int argc, char ** argv) {
+            for (int i { 1 }; i < argc; ++i) {
+                const std::string_view arg { argv[i] };
+                if (arg.starts_with("--pairs=")) {
+                    m_pairs = std::max(1u, static_cast<unsigned>(std::strtoul(arg.data() + 8, nullptr, 10)));
+                } else if (arg.starts_with("--placement=") && config::parse_placement(arg.substr(12))) {
+                    m_placement = *config::parse_placement(arg.substr(12));
+                } else if (arg.starts_with("--cpus=") && arg.size() > 7) {
+                    for (const char * pos { arg.data() + 7 }; *pos;) {
+                        char * end { nullptr };
+                        m_cpus.push_back(static_cast<unsigned>(std::strtoul(pos, &end, 10)));
+                        pos = *end == ',' ? end + 1 : end + (*end ? 1 : 0);
+                    }
+                }
+            }
+        }
+
+        /** CPU ids of the initiator and the responder of every pair **/
+        [[nodiscard]]
+        std::vector<std::pair<std::optional<unsigned>, std::optional<unsigned>>> plan() const {
+            std::vector<std::pair<std::optional<unsigned>, std::optional<unsigned>>> cpus(m_pairs);
+            if (!m_cpus.empty()) {
+                for (size_t i { 0 }; i < m_pairs; ++i) {
+                    cpus[i] = { m_cpus[(i << 1) % m_cpus.size()], m_cpus[((i << 1) + 1) % m_cpus.size()] };
+                }
+                return cpus;
+            }
+            const auto planned = config::system_topology().plan(m_placement, { m_pairs, m_pairs });
+            for (size_t i { 0 }; i < m_pairs; ++i) {
+                cpus[i] = { planned[i], planned[m_pairs + i] };
+            }
+            return cpus;
+        }
+    };
+
+    /**
+     * Repeats the attempt until it succeeds (true) or the queue is stopped (false). The wait is a busy loop with pause,
+     * so that a round trip never includes a trip through the scheduler; only a thread which isn't pinned yields after
+     * spinlock_spin_limit pauses, since its peer may be waiting for the same CPU.
+     */
+    template<class F>
+    bool retry(const bool pinned, F && attempt) {
+        for (unsigned spins { 0 };;) {
+            const auto status = attempt();
+            if (status == queue_slot_status::acquired) {
+                return true;
+            }
+            if (status == queue_slot_status::stopped) {
+                return false;
+            }
+            _mm_pause();
+            if (!pinned && ++spins >= xtxn::spinlock_spin_limit) {
+                spins = 0;
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template<class Q>
+    struct alignas(xtxn::false_sharing_align) pingpong_pair {
+        std::unique_ptr<Q> m_ping { std::make_unique<Q>() };
+        std::unique_ptr<Q> m_pong { std::make_unique<Q>() };
+        histogram m_latency {};
+    };
+
+    template<class Q>
+    result pingpong(const std::string_view name, const std::string_view params, const pingpong_options & options) {
+        const auto cpus = options.plan();
+        const auto pairs = std::make_unique<pingpong_pair<Q>[]>(options.m_pairs);
+        std::vector<std::jthread> pool {};
+        std::latch start { (options.m_pairs << 1) + 1 };
+        std::atomic<phase> current { phase::warmup };
+
+        const auto pin = [] (const std::optional<unsigned> cpu) {
+            return cpu && config::pin_current_thread(*cpu);
+        };
+
+        for (unsigned i { 0 }; i < options.m_pairs; ++i) {
+            pool.emplace_back(
+                [& pair = pairs[i], & start, & current, & pin, cpu = cpus[i].first] {
+                    const bool pinned { pin(cpu) };
+                    start.arrive_and_wait();
+                    item_type checksum { 0 };
+                    for (item_type sequence { 1 };; ++sequence) {
+                        const auto now = current.load(std::memory_order_relaxed);
+                        if (now == phase::stop) {
+                            break;
+                        }
+                        const auto started = xtxn::tsc_now();
+                        if (
+                            !retry(pinned, [& pair, sequence] { return produce(*pair.m_ping, sequence); })
+                            || !retry(pinned, [& pair, & checksum] { return consume(*pair.m_pong, checksum); })
+                        ) {
+                            break;
+                        }
+                        if (now == phase::measure) {
+                            pair.m_latency.record(xtxn::tsc_now() - started);
+                        }
+                    }
+                    leave(*pair.m_ping);
+                    leave(*pair.m_pong);
+                }
+            );
+            pool.emplace_back(
+                [& pair = pairs[i], & start, & pin, cpu = cpus[i].second] {
+                    const bool pinned { pin(cpu) };
+                    start.arrive_and_wait();
+                    item_type token { 0 };
+                    while (
+                        retry(pinned, [& pair, & token] { return consume(*pair.m_ping, token); })
+                        && retry(pinned, [& pair, & token] { return produce(*pair.m_pong, token); })
+                    ) {}
+                    leave(*pair.m_ping);
+                    leave(*pair.m_pong);
+                }
+            );
+        }
+
+        start.arrive_and_wait();
+        std::this_thread::sleep_for(warmup_time);
+        current.store(phase::measure, std::memory_order_relaxed);
+        const auto t1 = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(measure_time);
+        current.store(phase::stop, std::memory_order_relaxed);
+        const auto t2 = std::chrono::steady_clock::now();
+        for (unsigned i { 0 }; i < options.m_pairs; ++i) {
+            pairs[i].m_ping->stop();
+            pairs[i].m_pong->stop();
+        }
+        for (auto & thread : pool) {
+            thread.join();
+        }
+
+        histogram total {};
+        for (unsigned i { 0 }; i < options.m_pairs; ++i) {
+            total.merge(pairs[i].m_latency);
+        }
+        const double scale { 1.0 / xtxn::tsc_ticks_per_ns() };
+        const auto ns = [& total, scale] (const double q) {
+            return static_cast<uint64_t>(static_cast<double>(total.percentile(q)) * scale);
+        };
+
+        std::cout
+            << "   " << std::setw(30) << std::left << (std::string { name } + ' ' + std::string { params })
+            << std::right << " | " << std::setw(11) << total.count() << " | "
+            << std::setw(6) << ns(0.5) << '/' << std::setw(6) << ns(0.9) << '/' << std::setw(6) << ns(0.99) << '/'
+            << std::setw(7) << ns(0.999) << '/' << std::setw(9)
+            << static_cast<uint64_t>(static_cast<double>(total.max()) * scale) << '\n';
+
+        result record {};
+        record.m_queue = name;
+        record.m_params = params;
+        record.m_placement = options.m_cpus.empty() ? config::name(options.m_placement) : "explicit";
+        record.m_config = { options.m_pairs, options.m_pairs };
+        record.m_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+        record.m_produced = total.count();
+        record.m_consumed = total.count();
+        record.m_dequeue = total.summary(scale);
+        return record;
+    }
+
+    template<class Q>
+    void pingpong(
+        report & output,
+        const std::string_view name,
+        const std::string_view params,
+        const pingpong_options & options
+    ) {
+        for (unsigned run { 0 }; run < output.runs(); ++run) {
+            auto record = pingpong<Q>(name, params, options);
+            record.m_run = run;
+            output.add(std::move(record));
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+    using namespace xtxn;
+    using test::item_type;
+    using test::bench::pingpong;
+    using test::bench::pingpong_options;
+
+    init::console();
+    init::profiler();
+
+    test::bench::report report { argc, argv, &pingpong_options::accepts, pingpong_options::usage };
+    const pingpong_options options { argc, argv };
+
+    std::cout
+        << thick_separator
+        << "   Pairs: " << options.m_pairs << ", placement: "
+        << (options.m_cpus.empty() ? test::config::name(options.m_placement) : "explicit CPU list") << '\n'
+        << thick_separator
+        << "   QUEUE                          | ROUND TRIPS | RTT P50/P90/P99/P99.9/MAX NS\n"
+        << thin_separator;
+
+    pingpong<mpsc_queue<item_type>>(report, "mpsc", "", options);
+    pingpong<mpmc_queue<item_type>>(report, "mpmc", "", options);
+    pingpong<mpmcdd_queue<item_type, queue_purge_policy::deletions>>(report, "mpmcdd", "P=deletions", options);
+    pingpong<mpmcsl_queue<item_type>>(report, "mpmcsl", "", options);
+    pingpong<mpmchp_queue<item_type>>(report, "mpmchp", "", options);
+    pingpong<mpmctl_queue<item_type>>(report, "mpmctl", "", options);
+    pingpong<mpmctl_queue<item_type, true>>(report, "mpmctl", "F=1", options);
+    pingpong<static_fast_mpmc_queue<item_type, 1'000, true, 10>>(report, "static_fast", "S=1000 A=10", options);
+    pingpong<dynamic_fast_mpmc_queue<item_type, 100, 10, true, 10>>(report, "dynamic_fast", "S=100 L=10 A=10", options);
+
+    std::cout << thick_separator;
+    return report.save() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
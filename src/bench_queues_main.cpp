@@ -0,0 +1,78 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#include "init.hpp"
+#include "config.hpp"
+#include "bench.hpp"
+#include <xtxn/mpsc_queue.hpp>
+#include <xtxn/mpmc_queue.hpp>
+#include <xtxn/mpmcdd_queue.hpp>
+#include <xtxn/mpmcsl_queue.hpp>
+#include <xtxn/mpmchp_queue.hpp>
+#include <xtxn/mpmctl_queue.hpp>
+#include <xtxn/static_fast_mpmc_queue.hpp>
+#include <xtxn/dynamic_fast_mpmc_queue.hpp>
+#include <xtxn/bounded_fast_mpmc_queue.hpp>
+#include <xtxn/packed_fast_mpmc_queue.hpp>
+#include <xtxn/small_fast_mpmc_queue.hpp>
+#include <cstdlib>
+
+namespace {
+    /** The bounded queue with the capacity of the static one, chosen at run time **/
+    class bounded_fast_queue : public xtxn::bounded_fast_mpmc_queue<test::item_type, true, 10> {
+    public:
+        bounded_fast_queue() : bounded_fast_mpmc_queue { 1'000 } {}
+    };
+}
+
+int main(int argc, char ** argv) {
+    using namespace xtxn;
+    using test::item_type;
+
+    init::console();
+    init::profiler();
+
+    test::bench::report report { argc, argv };
+    const test::config::mpsc mpsc {};
+    const test::config::mpmc mpmc {};
+    const auto mpsc_sets = { mpsc.set_a, mpsc.set_b, mpsc.set_c, mpsc.set_d };
+    const auto mpmc_sets = { mpmc.set_a, mpmc.set_b, mpmc.set_c, mpmc.set_d };
+
+    const auto & topology = test::config::system_topology();
+    std::cout
+        << thick_separator
+        << "   Placement: " << test::config::name(report.placement()) << " (" << topology.sockets() << " socket(s), "
+        << topology.cores() << " core(s), " << topology.cpus().size() << " CPU(s))\n";
+
+    test::bench::print_header();
+
+    test::bench::perform<mpsc_queue<item_type>>(report, "mpsc", "", mpsc_sets);
+    test::bench::perform<mpmc_queue<item_type>>(report, "mpmc", "", mpmc_sets);
+    test::bench::perform<mpmcdd_queue<item_type, queue_purge_policy::deletions>>(
+        report, "mpmcdd", "P=deletions", mpmc_sets
+    );
+    test::bench::perform<mpmcsl_queue<item_type>>(report, "mpmcsl", "", mpmc_sets);
+    test::bench::perform<mpmchp_queue<item_type>>(report, "mpmchp", "", mpmc_sets);
+    test::bench::perform<mpmctl_queue<item_type>>(report, "mpmctl", "", mpmc_sets);
+    test::bench::perform<mpmctl_queue<item_type, true>>(report, "mpmctl", "F=1", mpmc_sets);
+    test::bench::perform<static_fast_mpmc_queue<item_type, 1'000, true, 10>>(
+        report, "static_fast", "S=1000 A=10", mpmc_sets
+    );
+    test::bench::perform<dynamic_fast_mpmc_queue<item_type, 100, 10, true, 10>>(
+        report, "dynamic_fast", "S=100 L=10 A=10", mpmc_sets
+    );
+    test::bench::perform<bounded_fast_queue>(report, "bounded_fast", "S=1000 A=10", mpmc_sets);
+    test::bench::perform<static_fast_mpmc_queue<uint32_t, 1'000, true, 10>>(
+        report, "static_fast", "S=1000 A=10 T=uint32", mpmc_sets
+    );
+    test::bench::perform<packed_fast_mpmc_queue<uint32_t, 1'000, 10>>(
+        report, "packed_fast", "S=1000 A=10 T=uint32", mpmc_sets
+    );
+    test::bench::perform<static_fast_mpmc_queue<item_type, 64, true, 10>>(
+        report, "static_fast", "S=64 A=10", mpmc_sets
+    );
+    test::bench::perform<small_fast_mpmc_queue<item_type, 64, true, 10>>(report, "small_fast", "S=64 A=10", mpmc_sets);
+
+    std::cout << thick_separator;
+    return report.save() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,413 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Machine-readable benchmark records. A report is written as CSV (one header line, one record per line) or as a JSON
+ * array of flat objects; read_results() accepts both, so result files of any format can be compared.
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "config.hpp"
+#include "perf_counters.hpp"
+#include <xtxn/latency_histogram.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#ifndef BENCH_REVISION
+#   define BENCH_REVISION "unknown"
+#endif
+
+namespace test::bench {
+    struct result {
+        std::string m_revision { BENCH_REVISION };
+        std::string m_queue {};
+        std::string m_params {};
+        std::string m_placement { config::name(config::placement::none) };
+        std::string m_payload {};
+        uint64_t m_payload_bytes { 0 }; /** bytes per item **/
+        config_set m_config {};
+        unsigned m_run { 0 };
+        int64_t m_duration { 0 }; /** nanoseconds **/
+        uint64_t m_produced { 0 };
+        uint64_t m_consumed { 0 };
+        xtxn::latency_summary m_enqueue {}; /** nanoseconds **/
+        xtxn::latency_summary m_dequeue {}; /** nanoseconds **/
+        perf_values m_counters {}; /** events of all threads per consumed item **/
+
+        [[nodiscard]]
+        double ops_per_second() const noexcept {
+            return m_duration ? static_cast<double>(m_consumed) * 1e9 / static_cast<double>(m_duration) : 0.0;
+        }
+
+        [[nodiscard]]
+        double bytes_per_second() const noexcept {
+            return ops_per_second() * static_cast<double>(m_payload_bytes);
+        }
+
+        [[nodiscard]]
+        double ns_per_op() const noexcept {
+            return m_consumed ? static_cast<double>(m_duration) / static_cast<double>(m_consumed) : 0.0;
+        }
+
+        /** Identifies the measured configuration regardless of the revision and the run **/
+        [[nodiscard]]
+        std::string key() const {
+            return m_queue + " [" + m_params + "] " + (m_payload.empty() ? "" : m_payload + ' ')
+                + (m_placement.empty() || m_placement == config::name(config::placement::none) ? "" : m_placement + ' ')
+                + std::to_string(m_config.first) + '/' + std::to_string(m_config.second);
+        }
+    };
+
+    namespace detail {
+        using fields = std::map<std::string, std::string, std::less<>>;
+
+        inline constexpr std::string_view columns[] {
+            "revision", "queue", "params", "placement", "payload", "payload_bytes", "producers", "consumers", "run",
+            "duration_ns", "produced", "consumed", "ops_per_s", "bytes_per_s", "ns_per_op", "enq_p50", "enq_p99",
+            "enq_p999", "enq_max", "deq_p50", "deq_p99", "deq_p999", "deq_max", "cycles_per_op", "instructions_per_op",
+            "l1d_misses_per_op", "llc_misses_per_op", "branch_misses_per_op", "coherence_per_op"
+        };
+
+        constexpr size_t first_counter_column { std::size(columns) - perf_event_count };
+
+        inline std::vector<std::string> values(const result & record) {
+            const auto number = [] (const auto value) { return std::to_string(value); };
+            std::vector<std::string> cells {
+                record.m_revision, record.m_queue, record.m_params, record.m_placement, record.m_payload,
+                number(record.m_payload_bytes),
+                number(record.m_config.first), number(record.m_config.second), number(record.m_run),
+                number(record.m_duration), number(record.m_produced), number(record.m_consumed),
+                number(static_cast<uint64_t>(record.ops_per_second())),
+                number(static_cast<uint64_t>(record.bytes_per_second())), number(record.ns_per_op()),
+                number(record.m_enqueue.m_p50), number(record.m_enqueue.m_p99),
+                number(record.m_enqueue.m_p999), number(record.m_enqueue.m_max),
+                number(record.m_dequeue.m_p50), number(record.m_dequeue.m_p99),
+                number(record.m_dequeue.m_p999), number(record.m_dequeue.m_max)
+            };
+            for (const auto & value : record.m_counters) {
+                cells.push_back(value ? number(*value) : std::string {});
+            }
+            return cells;
+        }
+
+        inline bool is_text(const std::string_view column) {
+            return column == "revision" || column == "queue" || column == "params" || column == "placement"
+                || column == "payload";
+        }
+
+        inline std::string quoted(const std::string_view text) {
+            std::string result { '"' };
+            for (const char c : text) {
+                if (c == '"' || c == '\\') {
+                    result += '\\';
+                }
+                result += c;
+            }
+            return result += '"';
+        }
+
+        template<typename U>
+        U number(const fields & record, const std::string_view column) {
+            U value {};
+            if (const auto it = record.find(column); it != record.end()) {
+                std::from_chars(it->second.data(), it->second.data() + it->second.size(), value);
+            }
+            return value;
+        }
+
+        inline result assemble(const fields & record) {
+            result item {};
+            const auto text = [& record] (const std::string_view column) {
+                const auto it = record.find(column);
+                return it == record.end() ? std::string {} : it->second;
+            };
+            item.m_revision = text("revision");
+            item.m_queue = text("queue");
+            item.m_params = text("params");
+            item.m_placement = text("placement");
+            item.m_payload = text("payload");
+            item.m_payload_bytes = number<uint64_t>(record, "payload_bytes");
+            item.m_config = { number<unsigned>(record, "producers"), number<unsigned>(record, "consumers") };
+            item.m_run = number<unsigned>(record, "run");
+            item.m_duration = number<int64_t>(record, "duration_ns");
+            item.m_produced = number<uint64_t>(record, "produced");
+            item.m_consumed = number<uint64_t>(record, "consumed");
+            item.m_enqueue = {
+                item.m_produced, number<uint64_t>(record, "enq_p50"), number<uint64_t>(record, "enq_p99"),
+                number<uint64_t>(record, "enq_p999"), number<uint64_t>(record, "enq_max")
+            };
+            item.m_dequeue = {
+                item.m_consumed, number<uint64_t>(record, "deq_p50"), number<uint64_t>(record, "deq_p99"),
+                number<uint64_t>(record, "deq_p999"), number<uint64_t>(record, "deq_max")
+            };
+            for (size_t i { 0 }; i < perf_event_count; ++i) {
+                const auto it = record.find(columns[first_counter_column + i]);
+                if (it == record.end()) {
+                    continue;
+                }
+                double value { 0.0 };
+                const auto & cell = it->second;
+                if (std::from_chars(cell.data(), cell.data() + cell.size(), value).ec == std::errc {}) {
+                    item.m_counters[i] = value;
+                }
+            }
+            return item;
+        }
+
+        /** Splits one CSV line, fields may be quoted with '"' (a quote inside is doubled) **/
+        inline std::vector<std::string> split_csv(const std::string_view line) {
+            std::vector<std::string> cells { std::string {} };
+            bool quoted { false };
+            for (size_t i { 0 }; i < line.size(); ++i) {
+                const char c { line[i] };
+                if (quoted) {
+                    if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                        cells.back() += c;
+                        ++i;
+                    } else if (c == '"') {
+                        quoted = false;
+                    } else {
+                        cells.back() += c;
+                    }
+                } else if (c == '"') {
+                    quoted = true;
+                } else if (c == ',') {
+                    cells.emplace_back();
+                } else if (c != '\r') {
+                    cells.back() += c;
+                }
+            }
+            return cells;
+        }
+
+        inline std::vector<result> read_csv(std::istream & stream) {
+            std::vector<result> results {};
+            std::string line {};
+            if (!std::getline(stream, line)) {
+                return results;
+            }
+            const auto header = split_csv(line);
+            while (std::getline(stream, line)) {
+                if (line.empty()) {
+                    continue;
+                }
+                const auto cells = split_csv(line);
+                fields record {};
+                for (size_t i { 0 }; i < header.size() && i < cells.size(); ++i) {
+                    record[header[i]] = cells[i];
+                }
+                results.push_back(assemble(record));
+            }
+            return results;
+        }
+
+        /** Reads an array of flat objects with string and number values, which is what write_json() produces **/
+        inline std::vector<result> read_json(std::istream & stream) {
+            std::vector<result> results {};
+            const std::string text { std::istreambuf_iterator<char> { stream }, std::istreambuf_iterator<char> {} };
+            size_t pos { 0 };
+
+            const auto skip = [& text, & pos] {
+                while (pos < text.size() && std::string_view { " \t\r\n" }.find(text[pos]) != std::string_view::npos) {
+                    ++pos;
+                }
+            };
+
+            const auto string = [& text, & pos] {
+                std::string value {};
+                for (++pos; pos < text.size() && text[pos] != '"'; ++pos) {
+                    if (text[pos] == '\\' && pos + 1 < text.size()) {
+                        ++pos;
+                    }
+                    value += text[pos];
+                }
+                ++pos;
+                return value;
+            };
+
+            while ((pos = text.find('{', pos)) != std::string::npos) {
+                ++pos;
+                fields record {};
+                for (skip(); pos < text.size() && text[pos] == '"'; skip()) {
+                    auto key = string();
+                    skip();
+                    ++pos; // ':'
+                    skip();
+                    if (pos < text.size() && text[pos] == '"') {
+                        record[std::move(key)] = string();
+                    } else {
+                        const auto end = text.find_first_of(",}", pos);
+                        auto value = text.substr(pos, end - pos);
+                        while (!value.empty() && (value.back() == ' ' || value.back() == '\n')) {
+                            value.pop_back();
+                        }
+                        record[std::move(key)] = std::move(value);
+                        pos = end;
+                    }
+                    skip();
+                    if (pos < text.size() && text[pos] == ',') {
+                        ++pos;
+                    }
+                }
+                results.push_back(assemble(record));
+            }
+            return results;
+        }
+    }
+
+    inline void write_csv(std::ostream & stream, const std::vector<result> & results) {
+        for (size_t i { 0 }; i < std::size(detail::columns); ++i) {
+            stream << (i ? "," : "") << detail::columns[i];
+        }
+        stream << '\n';
+        for (const auto & record : results) {
+            const auto cells = detail::values(record);
+            for (size_t i { 0 }; i < cells.size(); ++i) {
+                stream << (i ? "," : "");
+                if (detail::is_text(detail::columns[i])) {
+                    stream << '"';
+                    for (const char c : cells[i]) {
+                        if (c == '"') {
+                            stream << c;
+                        }
+                        stream << c;
+                    }
+                    stream << '"';
+                } else {
+                    stream << cells[i];
+                }
+            }
+            stream << '\n';
+        }
+    }
+
+    inline void write_json(std::ostream & stream, const std::vector<result> & results) {
+        stream << "[\n";
+        for (size_t r { 0 }; r < results.size(); ++r) {
+            const auto cells = detail::values(results[r]);
+            stream << "  {";
+            for (size_t i { 0 }; i < cells.size(); ++i) {
+                stream
+                    << (i ? ", " : "") << detail::quoted(detail::columns[i]) << ": "
+                    << (
+                        detail::is_text(detail::columns[i]) ? detail::quoted(cells[i])
+                        : cells[i].empty() ? std::string { "null" } : cells[i]
+                    );
+            }
+            stream << (r + 1 < results.size() ? "},\n" : "}\n");
+        }
+        stream << "]\n";
+    }
+
+    /** Reads a CSV or JSON result file, the format is detected by the first significant character **/
+    inline std::vector<result> read_results(std::istream & stream) {
+        stream >> std::ws;
+        const auto first = stream.peek();
+        return first == '[' || first == '{' ? detail::read_json(stream) : detail::read_csv(stream);
+    }
+
+    /**
+     * Command line: [--runs=N] [--placement=STRATEGY] [--counters] [--coherence=RAW] [--csv=FILE] [--json=FILE]
+     * --counters enables the hardware event counters, --coherence adds a raw (model-specific) coherence event to them.
+     * A benchmark with options of its own passes a predicate recognizing them (they are left to its own parser) and
+     * their usage line.
+     */
+    class report {
+        unsigned m_runs { 1 };
+        config::placement m_placement { config::placement::none };
+        perf_selection m_counters {};
+        std::string m_csv {};
+        std::string m_json {};
+        std::vector<result> m_results {};
+
+        static bool save(const std::string & path, const std::vector<result> & results, const bool json) {
+            if (path.empty()) {
+                return true;
+            }
+            std::ofstream file { path };
+            json ? write_json(file, results) : write_csv(file, results);
+            return static_cast<bool>(file);
+        }
+
+    public:
+        report(
+            const int argc,
+            char ** argv,
+            bool (* const own)(std::string_view) = nullptr,
+            const std::string_view usage = {}
+        ) {
+            for (int i { 1 }; i < argc; ++i) {
+                const std::string_view arg { argv[i] };
+                if (own && own(arg)) {
+                    continue;
+                }
+                if (arg.starts_with("--runs=")) {
+                    m_runs = std::max(1u, static_cast<unsigned>(std::strtoul(arg.data() + 7, nullptr, 10)));
+                } else if (arg.starts_with("--placement=") && config::parse_placement(arg.substr(12))) {
+                    m_placement = *config::parse_placement(arg.substr(12));
+                } else if (arg == "--counters") {
+                    m_counters.m_enabled = true;
+                } else if (arg.starts_with("--coherence=")) {
+                    m_counters.m_enabled = true;
+                    m_counters.m_coherence = std::strtoull(arg.data() + 12, nullptr, 0);
+                } else if (arg.starts_with("--csv=")) {
+                    m_csv = arg.substr(6);
+                } else if (arg.starts_with("--json=")) {
+                    m_json = arg.substr(7);
+                } else {
+                    std::cerr
+                        << "Usage: " << argv[0] << (usage.empty() ? "" : " ") << usage
+                        << " [--runs=N] [--placement=STRATEGY] [--counters] [--coherence=RAW]"
+                        << " [--csv=FILE] [--json=FILE]\n"
+                        << "Placement strategies: none, compact, scatter, sockets, smt_pairs\n";
+                    std::exit(EXIT_FAILURE);
+                }
+            }
+            if (m_counters.m_enabled && !perf_counters::supported()) {
+                std::cerr << "Hardware event counters are unavailable (perf_event_open, see perf_event_paranoid)\n";
+            }
+        }
+
+        report(const report &) = delete;
+        report(report &&) = delete;
+        ~report() = default;
+
+        report & operator=(const report &) = delete;
+        report & operator=(report &&) = delete;
+
+        [[nodiscard]]
+        unsigned runs() const noexcept {
+            return m_runs;
+        }
+
+        [[nodiscard]]
+        config::placement placement() const noexcept {
+            return m_placement;
+        }
+
+        [[nodiscard]]
+        const perf_selection & counters() const noexcept {
+            return m_counters;
+        }
+
+        void add(result record) {
+            m_results.push_back(std::move(record));
+        }
+
+        bool save() const {
+            return save(m_csv, m_results, false) && save(m_json, m_results, true);
+        }
+    };
+}
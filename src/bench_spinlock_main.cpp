@@ -0,0 +1,125 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#include "init.hpp"
+#include "messages.hpp"
+#include <xtxn/spinlock.hpp>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <latch>
+#include <iostream>
+#include <string_view>
+
+namespace test {
+    using xtxn::spin;
+    using xtxn::spinlock;
+
+#ifdef _DEBUG
+    constexpr std::chrono::milliseconds run_time { 20 };
+#else
+    constexpr std::chrono::milliseconds run_time { 250 };
+#endif
+    constexpr unsigned min_threads { 2 };
+    constexpr unsigned max_threads { 128 };
+
+    template<spin P>
+    bool perform(std::stringstream & stream, const std::string_view policy, const unsigned threads) {
+        spinlock<P> lock {};
+        std::vector<std::jthread> pool {};
+        std::vector<int64_t> done(threads, 0);
+        std::latch start { threads + 1 };
+        std::atomic_flag running {};
+        int64_t counter { 0 };
+
+        running.test_and_set(std::memory_order_relaxed);
+
+        for (unsigned i { 0 }; i < threads; ++i) {
+            pool.emplace_back(
+                [& lock, & start, & running, & counter, & ops = done[i]] {
+                    int64_t local { 0 };
+                    start.arrive_and_wait();
+                    while (running.test(std::memory_order_relaxed)) {
+                        std::scoped_lock guard { lock };
+                        ++counter;
+                        ++local;
+                    }
+                    ops = local;
+                }
+            );
+        }
+
+        start.arrive_and_wait();
+        const auto t1 = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(run_time);
+        running.clear(std::memory_order_relaxed);
+        for (auto & thread : pool) {
+            thread.join();
+        }
+        const auto t2 = std::chrono::steady_clock::now();
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+
+        int64_t total { 0 };
+        int64_t min_ops { std::numeric_limits<int64_t>::max() };
+        int64_t max_ops { 0 };
+        for (const auto ops : done) {
+            total += ops;
+            min_ops = std::min(min_ops, ops);
+            max_ops = std::max(max_ops, ops);
+        }
+
+        stream
+            << std::fixed << std::setprecision(2)
+            << "   " << std::setw(12) << std::left << policy << std::right << " | "
+            << std::setw(4) << threads << " | "
+            << std::setw(8) << (static_cast<double>(ns) / static_cast<double>(std::max<int64_t>(total, 1))) << " ns | "
+            << std::setw(7) << (static_cast<double>(total) * 1'000 / static_cast<double>(ns)) << " Mop/s | "
+            << std::setw(6) << (static_cast<double>(min_ops) / static_cast<double>(std::max<int64_t>(max_ops, 1)))
+            << '\n';
+
+        return counter == total;
+    }
+
+    template<spin P>
+    void perform(const std::string_view policy) {
+        for (unsigned threads { min_threads }; threads <= max_threads; threads <<= 1) {
+            std::stringstream str {};
+            if (!perform<P>(str, policy, threads)) {
+                std::cout << str.str() << thick_separator << tests_failed;
+                std::exit(EXIT_FAILURE);
+            }
+            std::cout << str.str() << std::flush;
+        }
+        std::cout << thin_separator;
+    }
+}
+
+int main(int, char **) {
+    using xtxn::spin;
+
+    init::console();
+    init::profiler();
+
+    std::cout
+        << thick_separator
+        << "   SPINLOCK POLICIES MICROBENCHMARK\n"
+        << thin_separator
+        << "   POLICY       | THR. |   PER OP.   |  THROUGHPUT   | FAIRNESS\n"
+        << thin_separator;
+
+    test::perform<spin::pause>("pause");
+    test::perform<spin::yield_thread>("yield_thread");
+    test::perform<spin::wait_flag>("wait_flag");
+    test::perform<spin::backoff>("backoff");
+    test::perform<spin::ticket>("ticket");
+    test::perform<spin::mcs>("mcs");
+    test::perform<spin::adaptive>("adaptive");
+
+    std::cout << thick_separator << all_tests_passed;
+    return EXIT_SUCCESS;
+}
@@ -5,12 +5,276 @@
 
 #include "types.hpp"
 #include <cassert>
+#include <cstdint>
 #include <algorithm>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
 #include <thread>
+#ifdef _WIN32
+#   include <windows.h>
+#elif defined(__linux__)
+#   include <sched.h>
+#   include <pthread.h>
+#endif
 
 namespace test::config {
+    struct cpu {
+        unsigned m_id { 0 };
+        unsigned m_socket { 0 };
+        unsigned m_core { 0 }; /** core id, unique within the socket **/
+    };
+
+    /**
+     * Thread placement strategies, producers take the first thread indices and consumers the following ones:
+     * compact - fill SMT siblings, then cores, then sockets;
+     * scatter - one thread per core, alternating sockets, SMT siblings only when cores run out;
+     * sockets - producers on the first socket, consumers on the second one (the same socket on single-socket hosts);
+     * smt_pairs - the n-th producer and the n-th consumer share a physical core.
+     */
+    enum class placement { none, compact, scatter, sockets, smt_pairs };
+
+    inline constexpr std::string_view placement_names[] { "none", "compact", "scatter", "sockets", "smt_pairs" };
+
+    [[nodiscard, maybe_unused]]
+    inline std::string_view name(const placement strategy) noexcept {
+        return placement_names[static_cast<size_t>(strategy)];
+    }
+
+    [[nodiscard, maybe_unused]]
+    inline std::optional<placement> parse_placement(const std::string_view text) noexcept {
+        for (size_t i { 0 }; i < std::size(placement_names); ++i) {
+            if (placement_names[i] == text) {
+                return static_cast<placement>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * CPUs available to the process. On Linux the list is the scheduler affinity mask (which already reflects the
+     * cgroup cpuset of the process) intersected with the cgroup cpuset files, the sockets and cores come from sysfs.
+     * Elsewhere every hardware thread is assumed to be a separate core of a single socket.
+     */
+    class topology {
+        std::vector<cpu> m_cpus {};
+        std::vector<std::vector<unsigned>> m_cores {}; /** CPU ids of each core, in the compact order **/
+        std::vector<unsigned> m_sockets {};
+
+#ifdef __linux__
+        static std::optional<unsigned> read_number(const std::string & path) {
+            std::ifstream file { path };
+            unsigned value { 0 };
+            if (file >> value) {
+                return value;
+            }
+            return std::nullopt;
+        }
+
+        /** Parses the kernel CPU list format, e.g. "0-3,8,10-11" **/
+        static std::vector<unsigned> read_list(const std::string & path) {
+            std::ifstream file { path };
+            std::string text {};
+            std::vector<unsigned> ids {};
+            if (!std::getline(file, text)) {
+                return ids;
+            }
+            size_t pos { 0 };
+            while (pos < text.size()) {
+                const auto end = std::min(text.find(',', pos), text.size());
+                const auto range = text.substr(pos, end - pos);
+                const auto dash = range.find('-');
+                try {
+                    const auto first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+                    const auto last = dash == std::string::npos
+                        ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+                    for (unsigned id { first }; id <= last; ++id) {
+                        ids.push_back(id);
+                    }
+                } catch (...) {
+                    return {};
+                }
+                pos = end + 1;
+            }
+            return ids;
+        }
+
+        static std::vector<unsigned> allowed() {
+            std::vector<unsigned> ids {};
+            cpu_set_t set {};
+            if (!::sched_getaffinity(0, sizeof(set), &set)) {
+                for (unsigned id { 0 }; id < CPU_SETSIZE; ++id) {
+                    if (CPU_ISSET(id, &set)) {
+                        ids.push_back(id);
+                    }
+                }
+            }
+            for (const auto * path : {
+                "/sys/fs/cgroup/cpuset.cpus.effective", "/sys/fs/cgroup/cpuset/cpuset.effective_cpus"
+            }) {
+                if (const auto limit = read_list(path); !limit.empty()) {
+                    std::erase_if(ids, [& limit] (const unsigned id) {
+                        return std::find(limit.begin(), limit.end(), id) == limit.end();
+                    });
+                    break;
+                }
+            }
+            return ids;
+        }
+#endif
+
+        [[nodiscard]]
+        const cpu & cpu_of(const unsigned id) const noexcept {
+            return *std::find_if(m_cpus.begin(), m_cpus.end(), [id] (const cpu & item) { return item.m_id == id; });
+        }
+
+        void detect() {
+#ifdef __linux__
+            for (const unsigned id : allowed()) {
+                const auto base = "/sys/devices/system/cpu/cpu" + std::to_string(id) + "/topology/";
+                m_cpus.push_back({
+                    id,
+                    read_number(base + "physical_package_id").value_or(0),
+                    read_number(base + "core_id").value_or(id)
+                });
+            }
+#endif
+            if (m_cpus.empty()) {
+                for (unsigned id { 0 }; id < std::max(std::thread::hardware_concurrency(), 1u); ++id) {
+                    m_cpus.push_back({ id, 0, id });
+                }
+            }
+        }
+
+    public:
+        topology() {
+            detect();
+            std::sort(m_cpus.begin(), m_cpus.end(), [] (const cpu & a, const cpu & b) {
+                return std::tie(a.m_socket, a.m_core, a.m_id) < std::tie(b.m_socket, b.m_core, b.m_id);
+            });
+            for (size_t i { 0 }; i < m_cpus.size(); ++i) {
+                const auto & item = m_cpus[i];
+                if (!i || item.m_socket != m_cpus[i - 1].m_socket || item.m_core != m_cpus[i - 1].m_core) {
+                    m_cores.emplace_back();
+                }
+                m_cores.back().push_back(item.m_id);
+                if (m_sockets.empty() || m_sockets.back() != item.m_socket) {
+                    m_sockets.push_back(item.m_socket);
+                }
+            }
+        }
+
+        topology(const topology &) = delete;
+        topology(topology &&) = delete;
+        ~topology() = default;
+
+        topology & operator=(const topology &) = delete;
+        topology & operator=(topology &&) = delete;
+
+        [[nodiscard, maybe_unused]]
+        const std::vector<cpu> & cpus() const noexcept {
+            return m_cpus;
+        }
+
+        [[nodiscard, maybe_unused]]
+        size_t cores() const noexcept {
+            return m_cores.size();
+        }
+
+        [[nodiscard, maybe_unused]]
+        size_t sockets() const noexcept {
+            return m_sockets.size();
+        }
+
+        /** CPU id for every thread of the configuration (producers first), an empty optional means "do not pin" **/
+        [[nodiscard, maybe_unused]]
+        std::vector<std::optional<unsigned>> plan(const placement strategy, const config_set & config) const {
+            const unsigned threads { config.first + config.second };
+            std::vector<std::optional<unsigned>> cpus(threads);
+            if (strategy == placement::none) {
+                return cpus;
+            }
+
+            std::vector<unsigned> order {};
+            if (strategy == placement::scatter) {
+                std::vector<std::tuple<size_t, size_t, size_t, unsigned>> keys {};
+                std::vector<size_t> per_socket(m_sockets.size(), 0);
+                for (const auto & core : m_cores) {
+                    const auto socket = static_cast<size_t>(
+                        std::find(m_sockets.begin(), m_sockets.end(), cpu_of(core.front()).m_socket) - m_sockets.begin()
+                    );
+                    const auto rank = per_socket[socket]++;
+                    for (size_t sibling { 0 }; sibling < core.size(); ++sibling) {
+                        keys.emplace_back(sibling, rank, socket, core[sibling]);
+                    }
+                }
+                std::sort(keys.begin(), keys.end());
+                for (const auto & key : keys) {
+                    order.push_back(std::get<3>(key));
+                }
+            }
+
+            for (unsigned i { 0 }; i < threads; ++i) {
+                const bool producer { i < config.first };
+                const unsigned n { producer ? i : i - config.first };
+                switch (strategy) {
+                    case placement::compact:
+                        cpus[i] = m_cpus[i % m_cpus.size()].m_id;
+                        break;
+                    case placement::scatter:
+                        cpus[i] = order[i % order.size()];
+                        break;
+                    case placement::sockets: {
+                        const unsigned socket { m_sockets[producer || m_sockets.size() < 2 ? 0 : 1] };
+                        std::vector<unsigned> ids {};
+                        for (const auto & item : m_cpus) {
+                            if (item.m_socket == socket) {
+                                ids.push_back(item.m_id);
+                            }
+                        }
+                        cpus[i] = ids[n % ids.size()];
+                        break;
+                    }
+                    case placement::smt_pairs: {
+                        const auto & core = m_cores[n % m_cores.size()];
+                        cpus[i] = core[(producer ? 0 : 1) % core.size()];
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+            return cpus;
+        }
+    };
+
+    [[nodiscard, maybe_unused]]
+    inline const topology & system_topology() {
+        static const topology s_topology {};
+        return s_topology;
+    }
+
+    /** Binds the calling thread to the CPU, returns false if the platform or the CPU does not allow it **/
+    [[maybe_unused]]
+    inline bool pin_current_thread(const unsigned id) noexcept {
+#ifdef _WIN32
+        return id < 64 && ::SetThreadAffinityMask(::GetCurrentThread(), DWORD_PTR { 1 } << id) != 0;
+#elif defined(__linux__)
+        cpu_set_t set {};
+        CPU_ZERO(&set);
+        CPU_SET(id, &set);
+        return !::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+#else
+        static_cast<void>(id);
+        return false;
+#endif
+    }
+
     inline unsigned baseline_concurrency() {
-        return std::max(std::thread::hardware_concurrency(), 2u);
+        return std::max(static_cast<unsigned>(system_topology().cpus().size()), 2u);
     }
 
     struct prelim {
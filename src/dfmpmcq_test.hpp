@@ -5,12 +5,14 @@
 
 #include "messages.hpp"
 #include "types.hpp"
+#include "backoff.hpp"
 #include <xtxn/dynamic_fast_mpmc_queue.hpp>
 #include <cassert>
 #include <cstdlib>
 #include <atomic>
 #include <chrono>
 #include <vector>
+#include <utility>
 #include <unordered_map>
 #include <thread>
 #include <latch>
@@ -39,6 +41,7 @@ namespace test {
     ) {
         return
             [& queue, & counter, & time, & successes, & fails, & latch] {
+                backoff wait {};
                 item_type value { counter.fetch_sub(1, std::memory_order_acq_rel) };
                 while (queue.producing() && value > 0) {
                     const auto t1 = std::chrono::steady_clock::now();
@@ -47,12 +50,13 @@ namespace test {
                     const auto t3 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
                     time.fetch_add(t3, std::memory_order_acq_rel);
                     if (slot) {
+                        wait.reset();
                         *slot = value;
                         value = counter.fetch_sub(1, std::memory_order_acq_rel);
                         successes.fetch_add(1, std::memory_order_acq_rel);
                     } else {
                         fails.fetch_add(1, std::memory_order_acq_rel);
-                        std::this_thread::yield();
+                        wait(slot.status());
                     }
                 }
                 latch.count_down();
@@ -69,18 +73,20 @@ namespace test {
     ) {
         return
             [& queue, & result, & time, & successes, & fails, & latch] {
+                backoff wait {};
                 while (queue.consuming()) {
                     const auto t1 = std::chrono::steady_clock::now();
-                    auto slot = queue.consumer_slot();
+                    auto slot = queue.consumer_slot(queue.c_default_attempts);
                     const auto t2 = std::chrono::steady_clock::now();
                     const auto t3 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
                     time.fetch_add(t3, std::memory_order_acq_rel);
                     if (slot) {
+                        wait.reset();
                         result.fetch_add(*slot, std::memory_order_acq_rel);
                         successes.fetch_add(1, std::memory_order_acq_rel);
                     } else {
                         fails.fetch_add(1, std::memory_order_acq_rel);
-                        std::this_thread::yield();
+                        wait(slot.status());
                     }
                 }
                 latch.count_down();
@@ -89,8 +95,20 @@ namespace test {
 
     template<any_dynamic_fast_mpmc_queue T>
     int perform(std::stringstream & stream, const item_type items, const config_set & config) {
+#ifdef MEMORY_PROFILING_HOOKS
+        const init::memory::thread_phase construction {};
+#endif
         T queue {};
         std::vector<std::jthread> pool {};
+#ifdef MEMORY_PROFILING_HOOKS
+        const auto queue_allocations = construction.allocations();
+        std::atomic_uint64_t worker_allocations { 0 };
+        const auto spawn = [& pool, & worker_allocations] (auto worker) {
+            pool.emplace_back(init::memory::counted(std::move(worker), worker_allocations));
+        };
+#else
+        const auto spawn = [& pool] (auto worker) { pool.emplace_back(std::move(worker)); };
+#endif
         std::latch latch { config.first + config.second + 1 };
         std::atomic_int_fast64_t pro_time { 0 };
         std::atomic_int_fast64_t pro_successes { 0 };
@@ -104,11 +122,11 @@ namespace test {
         const auto t1 = std::chrono::steady_clock::now();
 
         for (unsigned i { config.second }; i; --i) {
-            pool.emplace_back(create_consumer(queue, result, con_time, con_successes, con_fails, latch));
+            spawn(create_consumer(queue, result, con_time, con_successes, con_fails, latch));
         }
 
         for (unsigned i { config.first }; i; --i) {
-            pool.emplace_back(create_producer(queue, counter, pro_time, pro_successes, pro_fails, latch));
+            spawn(create_producer(queue, counter, pro_time, pro_successes, pro_fails, latch));
         }
 
         while (counter.load() > 0 || con_successes.load() < items) {
@@ -121,7 +139,20 @@ namespace test {
 
         const auto t2 = std::chrono::steady_clock::now();
         const auto t3 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
-        const int exit_code { result.load() == (items * (items + 1)) >> 1 ? EXIT_SUCCESS : EXIT_FAILURE };
+#ifdef MEMORY_PROFILING_HOOKS
+        // The dynamic queue allocates its first block in the constructor and one block per grow()
+        const auto expected_allocations = static_cast<uint64_t>(
+            (queue.capacity() - T::c_block_size) / T::c_block_size
+        );
+        const bool allocations_ok {
+            queue_allocations == 1 && worker_allocations.load() == expected_allocations
+        };
+#else
+        constexpr bool allocations_ok { true };
+#endif
+        const int exit_code {
+            result.load() == (items * (items + 1)) >> 1 && allocations_ok ? EXIT_SUCCESS : EXIT_FAILURE
+        };
 
         summary_a(stream, items);
         summary_b(stream, gp_labels.at(T::c_growth_policy), T::c_default_attempts);
@@ -132,6 +163,9 @@ namespace test {
         );
 
         summary_d(stream, queue.capacity(), T::c_block_size, T::c_max_capacity);
+#ifdef MEMORY_PROFILING_HOOKS
+        summary_f(stream, queue_allocations, worker_allocations.load(), expected_allocations);
+#endif
         summary_e(stream, exit_code == EXIT_SUCCESS, t3);
 
         return exit_code;
@@ -1,4 +1,4 @@
-// Copyright (c) 2025 Vitaly Anasenko
+// Copyright (c) 2025-2026 Vitaly Anasenko
 // Distributed under the MIT License, see accompanying file LICENSE.txt
 
 #pragma once
@@ -24,10 +24,144 @@
 #   else
 #       undef ENABLE_MEMORY_PROFILING
 #   endif
+#elif defined(__linux__)
+#   if defined(ENABLE_MEMORY_PROFILING) && defined(_DEBUG)
+#       define MEMORY_PROFILING_HOOKS
+#       include <malloc.h>
+#       include <cstdint>
+#       include <cstdlib>
+#       include <atomic>
+#       include <fstream>
+#       include <iostream>
+#       include <new>
+#       include <string>
+#       include <utility>
+#   endif
 #else
 #   undef ENABLE_MEMORY_PROFILING
 #endif
 
+#ifdef MEMORY_PROFILING_HOOKS
+/**
+ * Allocation accounting for Linux builds with ENABLE_MEMORY_PROFILING. The global allocation functions are replaced
+ * (this header is included by exactly one translation unit of every executable), the sizes are taken from
+ * malloc_usable_size(). Totals are process-wide, thread_allocations() counts the calling thread only, so a worker can
+ * check its own loop regardless of what other threads do.
+ */
+namespace init::memory {
+    struct counters {
+        uint64_t m_allocations { 0 };
+        uint64_t m_deallocations { 0 };
+        uint64_t m_bytes { 0 };
+        uint64_t m_peak_bytes { 0 };
+    };
+
+    namespace detail {
+        inline std::atomic_uint64_t s_allocations { 0 };
+        inline std::atomic_uint64_t s_deallocations { 0 };
+        inline std::atomic_uint64_t s_bytes { 0 };
+        inline std::atomic_uint64_t s_peak_bytes { 0 };
+        inline thread_local uint64_t t_allocations { 0 };
+
+        inline void * allocated(void * pointer) {
+            if (!pointer) {
+                throw std::bad_alloc {};
+            }
+            const auto bytes = s_bytes.fetch_add(::malloc_usable_size(pointer), std::memory_order_relaxed)
+                + ::malloc_usable_size(pointer);
+            auto peak = s_peak_bytes.load(std::memory_order_relaxed);
+            while (peak < bytes && !s_peak_bytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {}
+            s_allocations.fetch_add(1, std::memory_order_relaxed);
+            ++t_allocations;
+            return pointer;
+        }
+
+        inline void release(void * pointer) noexcept {
+            if (pointer) {
+                s_bytes.fetch_sub(::malloc_usable_size(pointer), std::memory_order_relaxed);
+                s_deallocations.fetch_add(1, std::memory_order_relaxed);
+                std::free(pointer);
+            }
+        }
+    }
+
+    [[nodiscard, maybe_unused]]
+    inline counters snapshot() noexcept {
+        return {
+            detail::s_allocations.load(std::memory_order_relaxed),
+            detail::s_deallocations.load(std::memory_order_relaxed),
+            detail::s_bytes.load(std::memory_order_relaxed),
+            detail::s_peak_bytes.load(std::memory_order_relaxed)
+        };
+    }
+
+    [[nodiscard, maybe_unused]]
+    inline uint64_t thread_allocations() noexcept {
+        return detail::t_allocations;
+    }
+
+    /** Peak resident set size in KiB (VmHWM), zero if /proc is not available **/
+    [[nodiscard, maybe_unused]]
+    inline uint64_t peak_rss() {
+        std::ifstream status { "/proc/self/status" };
+        std::string line {};
+        while (std::getline(status, line)) {
+            if (line.starts_with("VmHWM:")) {
+                return std::strtoull(line.c_str() + 6, nullptr, 10);
+            }
+        }
+        return 0;
+    }
+
+    /** Allocations made by the calling thread since the construction **/
+    class thread_phase {
+        uint64_t m_start { thread_allocations() };
+
+    public:
+        [[nodiscard, maybe_unused]]
+        uint64_t allocations() const noexcept {
+            return thread_allocations() - m_start;
+        }
+    };
+
+    /** Wraps a thread function so that the allocations it makes are added to the total **/
+    template<class F>
+    auto counted(F worker, std::atomic_uint64_t & total) {
+        return [worker = std::move(worker), & total] () mutable {
+            const thread_phase phase {};
+            worker();
+            total.fetch_add(phase.allocations(), std::memory_order_relaxed);
+        };
+    }
+}
+
+void * operator new(const std::size_t size) {
+    return init::memory::detail::allocated(std::malloc(size ? size : 1));
+}
+
+void * operator new(const std::size_t size, const std::align_val_t align) {
+    const auto alignment = static_cast<std::size_t>(align);
+    const auto rounded = (size + alignment - 1) / alignment * alignment;
+    return init::memory::detail::allocated(std::aligned_alloc(alignment, rounded ? rounded : alignment));
+}
+
+void operator delete(void * pointer) noexcept {
+    init::memory::detail::release(pointer);
+}
+
+void operator delete(void * pointer, std::align_val_t) noexcept {
+    init::memory::detail::release(pointer);
+}
+
+void operator delete(void * pointer, std::size_t) noexcept {
+    init::memory::detail::release(pointer);
+}
+
+void operator delete(void * pointer, std::size_t, std::align_val_t) noexcept {
+    init::memory::detail::release(pointer);
+}
+#endif
+
 namespace init {
     inline void console() {
 #ifdef _WIN32
@@ -38,7 +172,17 @@ namespace init {
     }
 
     inline void profiler() {
-#ifdef ENABLE_MEMORY_PROFILING
+#if defined(MEMORY_PROFILING_HOOKS)
+        std::cout << "!! Enabled memory profiling !!" << std::endl;
+        std::atexit([] {
+            const auto totals = memory::snapshot();
+            std::cout
+                << "   Memory profile: " << totals.m_allocations << " allocations, " << totals.m_deallocations
+                << " deallocations, " << totals.m_allocations - totals.m_deallocations << " blocks ("
+                << totals.m_bytes << " bytes) still allocated, peak heap " << totals.m_peak_bytes << " bytes, peak RSS "
+                << memory::peak_rss() << " KiB" << std::endl;
+        });
+#elif defined(ENABLE_MEMORY_PROFILING)
         std::cout << "!! Enabled memory profiling !!" << std::endl;
         constexpr auto report_mode = /*_CRTDBG_MODE_DEBUG |*/ _CRTDBG_MODE_FILE /*| _CRTDBG_MODE_WNDW*/;
         ::_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_CHECK_ALWAYS_DF | _CRTDBG_LEAK_CHECK_DF);
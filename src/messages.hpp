@@ -133,6 +133,17 @@ void summary_d(
         << "   Queue capacity: " << capacity << '\n';
 }
 
+inline void summary_f(
+    std::stringstream & stream,
+    const uint64_t construction,
+    const uint64_t workers,
+    const uint64_t expected
+) {
+    stream
+        << "   Allocations: " << construction << " in construction, " << workers << " in workers (expected: "
+        << expected << ")\n";
+}
+
 inline void summary_e(
     std::stringstream & stream,
     const bool ok,
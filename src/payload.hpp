@@ -0,0 +1,149 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Benchmark payloads. payload<V> creates a value from the sequence number, folds a received value into a checksum and
+ * tells its size, so the same benchmark can be run with scalars, fixed-size blobs and heap-allocating types.
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace test {
+    constexpr size_t string_payload_length { 0x40 };
+    constexpr size_t vector_payload_length { 0x40 };
+
+    /** Trivially copyable payload of N bytes, only the first and the last words carry data **/
+    template<size_t N>
+    requires (N >= sizeof(item_type)) && (N % sizeof(item_type) == 0)
+    struct blob {
+        item_type m_words[N / sizeof(item_type)] {};
+    };
+
+    template<typename V>
+    struct payload;
+
+    template<>
+    struct payload<item_type> {
+        static std::string name() {
+            return "int64";
+        }
+
+        static item_type make(const item_type sequence) noexcept {
+            return sequence;
+        }
+
+        static item_type fold(const item_type value) noexcept {
+            return value;
+        }
+
+        static size_t bytes(const item_type &) noexcept {
+            return sizeof(item_type);
+        }
+    };
+
+    template<>
+    struct payload<uint32_t> {
+        static std::string name() {
+            return "uint32";
+        }
+
+        static uint32_t make(const item_type sequence) noexcept {
+            return static_cast<uint32_t>(sequence);
+        }
+
+        static item_type fold(const uint32_t value) noexcept {
+            return value;
+        }
+
+        static size_t bytes(const uint32_t &) noexcept {
+            return sizeof(uint32_t);
+        }
+    };
+
+    template<size_t N>
+    struct payload<blob<N>> {
+        static std::string name() {
+            return std::to_string(N) + " B";
+        }
+
+        static blob<N> make(const item_type sequence) noexcept {
+            blob<N> value;
+            value.m_words[0] = sequence;
+            value.m_words[std::size(value.m_words) - 1] = sequence;
+            return value;
+        }
+
+        static item_type fold(const blob<N> & value) noexcept {
+            return (value.m_words[0] + value.m_words[std::size(value.m_words) - 1]) >> 1;
+        }
+
+        static size_t bytes(const blob<N> &) noexcept {
+            return N;
+        }
+    };
+
+    template<>
+    struct payload<std::string> {
+        static std::string name() {
+            return "string";
+        }
+
+        static std::string make(const item_type sequence) {
+            std::string value(string_payload_length, 'x');
+            value.front() = static_cast<char>('0' + sequence % 10);
+            return value;
+        }
+
+        static item_type fold(const std::string & value) noexcept {
+            return value.empty() ? 0 : value.front() - '0';
+        }
+
+        static size_t bytes(const std::string & value) noexcept {
+            return value.size();
+        }
+    };
+
+    template<>
+    struct payload<std::vector<item_type>> {
+        static std::string name() {
+            return "vector";
+        }
+
+        static std::vector<item_type> make(const item_type sequence) {
+            std::vector<item_type> value(vector_payload_length, 0);
+            value.front() = sequence;
+            return value;
+        }
+
+        static item_type fold(const std::vector<item_type> & value) noexcept {
+            return value.empty() ? 0 : value.front();
+        }
+
+        static size_t bytes(const std::vector<item_type> & value) noexcept {
+            return value.size() * sizeof(item_type);
+        }
+    };
+
+    /** Payload type of a queue: the fast queues name it, the linked ones return it from dequeue() **/
+    template<class Q>
+    struct queue_payload {
+        using type = typename decltype(std::declval<Q &>().dequeue())::element_type;
+    };
+
+    template<class Q>
+    requires requires { typename Q::payload_type; }
+    struct queue_payload<Q> {
+        using type = typename Q::payload_type;
+    };
+
+    template<class Q>
+    using queue_payload_t = typename queue_payload<Q>::type;
+}
@@ -0,0 +1,178 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Hardware event counters of a thread (Linux perf_event_open). Every event is opened separately for the calling thread
+ * only, user space only, so the counters work with the default perf_event_paranoid level and are scaled when the kernel
+ * multiplexes them. There is no portable coherence event: a raw, model-specific event code (e.g. 0x04d2, snoop HITM
+ * loads on Skylake) has to be supplied. Events the host does not support are reported as unavailable; on other systems
+ * all of them are.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string_view>
+#ifdef __linux__
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+namespace test::bench {
+    enum class perf_event : unsigned { cycles, instructions, l1d_misses, llc_misses, branch_misses, coherence };
+
+    inline constexpr std::string_view perf_event_names[] {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "coherence"
+    };
+
+    constexpr size_t perf_event_count { std::size(perf_event_names) };
+
+    /** Counts per operation, empty for the events that were not counted **/
+    using perf_values = std::array<std::optional<double>, perf_event_count>;
+
+    struct perf_selection {
+        bool m_enabled { false };
+        std::optional<uint64_t> m_coherence {}; /** raw event code **/
+    };
+
+    class perf_counters {
+        std::array<int, perf_event_count> m_files {};
+        std::array<std::optional<uint64_t>, perf_event_count> m_counts {};
+
+#ifdef __linux__
+        static int open(const uint32_t type, const uint64_t config) noexcept {
+            perf_event_attr attr {};
+            attr.size = sizeof(perf_event_attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+
+        void close() noexcept {
+            for (auto & file : m_files) {
+#ifdef __linux__
+                if (file >= 0) {
+                    ::close(file);
+                }
+#endif
+                file = -1;
+            }
+        }
+
+    public:
+        perf_counters() noexcept {
+            m_files.fill(-1);
+        }
+
+        perf_counters(const perf_counters &) = delete;
+        perf_counters(perf_counters &&) = delete;
+
+        ~perf_counters() noexcept {
+            close();
+        }
+
+        perf_counters & operator=(const perf_counters &) = delete;
+        perf_counters & operator=(perf_counters &&) = delete;
+
+        /** Opens the selected events for the calling thread, returns false if none of them is available **/
+        bool open(const perf_selection & selection) noexcept {
+            close();
+            m_counts.fill(std::nullopt);
+            if (!selection.m_enabled) {
+                return false;
+            }
+#ifdef __linux__
+            constexpr auto cache = [] (const uint64_t id) {
+                return id | (uint64_t { PERF_COUNT_HW_CACHE_OP_READ } << 8)
+                    | (uint64_t { PERF_COUNT_HW_CACHE_RESULT_MISS } << 16);
+            };
+            m_files = {
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+                open(PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_L1D)),
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES),
+                selection.m_coherence ? open(PERF_TYPE_RAW, *selection.m_coherence) : -1
+            };
+#endif
+            return std::ranges::any_of(m_files, [] (const int file) { return file >= 0; });
+        }
+
+        void start() noexcept {
+#ifdef __linux__
+            for (const int file : m_files) {
+                if (file >= 0) {
+                    ::ioctl(file, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        /** Disables the events and keeps their counts, scaled up if the events were multiplexed **/
+        void stop() noexcept {
+#ifdef __linux__
+            for (size_t i { 0 }; i < perf_event_count; ++i) {
+                if (m_files[i] < 0) {
+                    continue;
+                }
+                ::ioctl(m_files[i], PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t data[3] {}; // value, time enabled, time running
+                if (::read(m_files[i], data, sizeof(data)) == sizeof(data) && data[2]) {
+                    m_counts[i] = data[1] == data[2]
+                        ? data[0]
+                        : static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1])
+                            / static_cast<double>(data[2]));
+                }
+            }
+#endif
+        }
+
+        [[nodiscard, maybe_unused]]
+        std::optional<uint64_t> count(const perf_event event) const noexcept {
+            return m_counts[static_cast<size_t>(event)];
+        }
+
+        /** Whether the calling thread can count cycles at all **/
+        [[nodiscard, maybe_unused]]
+        static bool supported() noexcept {
+            perf_counters probe {};
+            return probe.open({ true, std::nullopt }) && probe.m_files[0] >= 0;
+        }
+    };
+
+    /** Sums the counts of several threads **/
+    class perf_totals {
+        std::array<std::optional<uint64_t>, perf_event_count> m_sums {};
+
+    public:
+        void add(const perf_counters & counters) noexcept {
+            for (size_t i { 0 }; i < perf_event_count; ++i) {
+                if (const auto value = counters.count(static_cast<perf_event>(i)); value) {
+                    m_sums[i] = m_sums[i].value_or(0) + *value;
+                }
+            }
+        }
+
+        [[nodiscard]]
+        perf_values per_op(const uint64_t ops) const noexcept {
+            perf_values values {};
+            for (size_t i { 0 }; i < perf_event_count; ++i) {
+                if (m_sums[i] && ops) {
+                    values[i] = static_cast<double>(*m_sums[i]) / static_cast<double>(ops);
+                }
+            }
+            return values;
+        }
+    };
+}
@@ -4,7 +4,9 @@
 #include "init.hpp"
 #include "config.hpp"
 #include "messages.hpp"
+#include "backoff.hpp"
 #include <xtxn/dynamic_fast_mpmc_queue.hpp>
+#include <xtxn/fast_mpmc_queue_trace.hpp>
 #include <xtxn/static_fast_mpmc_queue.hpp>
 #include <xtxn/mpmc_queue.hpp>
 #include <cassert>
@@ -12,17 +14,35 @@
 #include <cstdint>
 #include <atomic>
 #include <chrono>
+#include <string>
+#include <string_view>
 #include <vector>
 #include <thread>
 #include <latch>
 #include <iostream>
 
-int main(int, char **) {
+template<xtxn::queue_stats_policy M>
+using dynamic_queue = xtxn::dynamic_fast_mpmc_queue<
+    test::item_type, 100, 400, true, 1, xtxn::queue_growth_policy::call, M
+>;
+
+int main(int argc, char ** argv) {
     using namespace xtxn;
+    using test::backoff;
 
     init::console();
     init::profiler();
 
+    std::string trace {};
+    for (int i { 1 }; i < argc; ++i) {
+        if (const std::string_view arg { argv[i] }; arg.starts_with("--trace=")) {
+            trace = arg.substr(8);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--trace=FILE]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
     const unsigned producers { std::thread::hardware_concurrency() << 2 };
     const unsigned consumers { producers };
 #ifdef _DEBUG
@@ -31,9 +51,9 @@ int main(int, char **) {
     constexpr int64_t items { 10'000'000 };
 #endif
 
-    {
+    const auto dynamic_queue_test = [producers, consumers] <class Q> ([[maybe_unused]] const std::string & trace) {
         std::stringstream str {};
-        dynamic_fast_mpmc_queue<test::item_type, 100, 400, true, 1, queue_growth_policy::call> queue {};
+        Q queue {};
         std::vector<std::jthread> pool {};
         std::latch latch { producers + consumers + 1 };
         std::atomic_int_fast64_t consumed { 0 };
@@ -47,12 +67,14 @@ int main(int, char **) {
         for (unsigned i { consumers }; i; --i) {
             pool.emplace_back(
                 [& queue, & result, & consumed, & latch] {
+                    backoff wait {};
                     while (queue.consuming()) {
                         if (auto slot = queue.consumer_slot(); slot) {
+                            wait.reset();
                             result.fetch_add(*slot, std::memory_order_acq_rel);
                             consumed.fetch_add(1, std::memory_order_acq_rel);
                         } else {
-                            std::this_thread::yield();
+                            wait(slot.status());
                         }
                     }
                     latch.count_down();
@@ -63,13 +85,15 @@ int main(int, char **) {
         for (unsigned i { producers }; i; --i) {
             pool.emplace_back(
                 [& queue, & counter, & latch] {
+                    backoff wait {};
                     int_fast64_t value { counter.fetch_sub(1, std::memory_order_acq_rel) };
                     while (queue.producing() && value > 0) {
                         if (auto slot = queue.producer_slot(); slot) {
+                            wait.reset();
                             *slot = value;
                             value = counter.fetch_sub(1, std::memory_order_acq_rel);
                         } else {
-                            std::this_thread::yield();
+                            wait(slot.status());
                         }
                     }
                     latch.count_down();
@@ -89,6 +113,18 @@ int main(int, char **) {
         const auto t3 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
         summary_e(str, result.load() == (items * (items + 1)) >> 1, t3);
         std::cout << str.str() << thick_separator;
+
+        if constexpr (Q::c_trace) {
+            if (!queue.dump_trace(trace)) {
+                std::cerr << "Can't write trace " << trace << '\n';
+            }
+        }
+    };
+
+    if (trace.empty()) {
+        dynamic_queue_test.template operator()<dynamic_queue<queue_no_stats>>(trace);
+    } else {
+        dynamic_queue_test.template operator()<dynamic_queue<queue_trace<>>>(trace);
     }
 
     {
@@ -107,12 +143,14 @@ int main(int, char **) {
         for (unsigned i { consumers }; i; --i) {
             pool.emplace_back(
                 [& queue, & result, & consumed, & latch] {
+                    backoff wait {};
                     while (queue.consuming()) {
                         if (auto slot = queue.consumer_slot(); slot) {
+                            wait.reset();
                             result.fetch_add(*slot, std::memory_order_acq_rel);
                             consumed.fetch_add(1, std::memory_order_acq_rel);
                         } else {
-                            std::this_thread::yield();
+                            wait(slot.status());
                         }
                     }
                     latch.count_down();
@@ -123,13 +161,15 @@ int main(int, char **) {
         for (unsigned i { producers }; i; --i) {
             pool.emplace_back(
                 [& queue, & counter, & latch] {
+                    backoff wait {};
                     int_fast64_t value { counter.fetch_sub(1, std::memory_order_acq_rel) };
                     while (queue.producing() && value > 0) {
                         if (auto slot = queue.producer_slot(); slot) {
+                            wait.reset();
                             *slot = value;
                             value = counter.fetch_sub(1, std::memory_order_acq_rel);
                         } else {
-                            std::this_thread::yield();
+                            wait(slot.status());
                         }
                     }
                     latch.count_down();
@@ -13,5 +13,13 @@ int main(int, char **) {
         "CLASSIC MPMC QUEUE TEST (DEFERRED DELETION)",
         test::config::mpmc {}
     );
+    test::perform<xtxn::mpmcdd_queue<test::item_type, xtxn::queue_purge_policy::deletions>>(
+        "CLASSIC MPMC QUEUE TEST (DEFERRED DELETION, PURGE AFTER DELETIONS)",
+        test::config::mpmc {}
+    );
+    test::perform<xtxn::mpmcdd_queue<test::item_type, xtxn::queue_purge_policy::length>>(
+        "CLASSIC MPMC QUEUE TEST (DEFERRED DELETION, PURGE BY LIST LENGTH)",
+        test::config::mpmc {}
+    );
     return EXIT_SUCCESS;
 }
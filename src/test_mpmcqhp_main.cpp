@@ -0,0 +1,17 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#include "init.hpp"
+#include "config.hpp"
+#include "queue_test.hpp"
+#include <xtxn/mpmchp_queue.hpp>
+
+int main(int, char **) {
+    init::console();
+    init::profiler();
+    test::perform<xtxn::mpmchp_queue<test::item_type>>(
+        "CLASSIC MPMC QUEUE TEST (HAZARD POINTER RECLAMATION)",
+        test::config::mpmc {}
+    );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,21 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#include "init.hpp"
+#include "config.hpp"
+#include "queue_test.hpp"
+#include <xtxn/mpmctl_queue.hpp>
+
+int main(int, char **) {
+    init::console();
+    init::profiler();
+    test::perform<xtxn::mpmctl_queue<test::item_type>>(
+        "CLASSIC MPMC QUEUE TEST (TWO LOCKS)",
+        test::config::mpmc {}
+    );
+    test::perform<xtxn::mpmctl_queue<test::item_type, true>>(
+        "CLASSIC MPMC QUEUE TEST (TWO LOCKS, FLAT COMBINING DEQUEUE)",
+        test::config::mpmc {}
+    );
+    return EXIT_SUCCESS;
+}
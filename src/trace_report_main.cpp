@@ -0,0 +1,254 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+/**
+ * Offline analysis of a slot state trace written by queue_trace::dump(). The transitions are grouped by slot to
+ * reconstruct the slot timelines; every stay in prod_locked or cons_locked is a lock hold. The report lists the hold
+ * time distribution of both lock states, the longest holds and the threads that made them. A slot still locked at the
+ * end of the trace is reported as held until the last record. Rings that wrapped around have lost their oldest
+ * records, so only the window covered by all rings is analysed; transitions lost anyway (e.g. torn records) show up
+ * as gaps, where the old state of a record does not match the previous new state of its slot.
+ *
+ * Usage: trace_report FILE [--top=N] [--slot=ID]
+ * --slot prints the timeline of one slot (its index or address as printed in the report).
+ */
+
+#include "messages.hpp"
+#include <xtxn/fast_mpmc_queue_commons.hpp>
+#include <xtxn/fast_mpmc_queue_trace.hpp>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using xtxn::queue_slot_state;
+    using xtxn::queue_trace_header;
+    using xtxn::queue_trace_record;
+
+    struct hold {
+        uint64_t m_slot { 0 };
+        uint32_t m_thread { 0 };
+        queue_slot_state m_state { queue_slot_state::prod_locked };
+        uint64_t m_start { 0 };
+        uint64_t m_ticks { 0 };
+        bool m_released { true };
+    };
+
+    struct trace {
+        queue_trace_header m_header {};
+        std::vector<queue_trace_record> m_records {};
+        size_t m_dropped { 0 }; /** records before the window covered by all rings **/
+    };
+
+    std::string_view name(const uint8_t state) {
+        constexpr std::string_view names[] { "free", "prod_locked", "ready", "cons_locked" };
+        return state < std::size(names) ? names[state] : "?";
+    }
+
+    bool locked(const uint8_t state) {
+        return state == static_cast<uint8_t>(queue_slot_state::prod_locked)
+            || state == static_cast<uint8_t>(queue_slot_state::cons_locked);
+    }
+
+    std::optional<trace> read_trace(const std::string & path) {
+        std::ifstream file { path, std::ios::binary };
+        trace result {};
+        if (!file.read(reinterpret_cast<char *>(&result.m_header), sizeof(queue_trace_header))) {
+            return std::nullopt;
+        }
+        if (
+            std::memcmp(result.m_header.m_magic, queue_trace_header {}.m_magic, sizeof(result.m_header.m_magic))
+            || result.m_header.m_record_size != sizeof(queue_trace_record)
+        ) {
+            return std::nullopt;
+        }
+        result.m_records.resize(result.m_header.m_records);
+        const auto bytes = static_cast<std::streamsize>(result.m_records.size() * sizeof(queue_trace_record));
+        if (!file.read(reinterpret_cast<char *>(result.m_records.data()), bytes)) {
+            return std::nullopt;
+        }
+        std::ranges::stable_sort(result.m_records, {}, &queue_trace_record::m_tsc);
+
+        // A thread writes to ring 'thread % rings', a full ring has wrapped and lost what preceded its first record
+        const auto rings = std::max(1u, result.m_header.m_rings);
+        std::map<uint32_t, std::pair<uint64_t, uint64_t>> fill {}; // ring -> records, first TSC
+        for (const auto & record : result.m_records) {
+            auto & [count, first] = fill[record.m_thread % rings];
+            first = count++ ? first : record.m_tsc;
+        }
+        uint64_t start { 0 };
+        for (const auto & [ring, usage] : fill) {
+            if (usage.first >= result.m_header.m_ring_records) {
+                start = std::max(start, usage.second);
+            }
+        }
+        const auto first_kept = std::ranges::lower_bound(result.m_records, start, {}, &queue_trace_record::m_tsc);
+        result.m_dropped = static_cast<size_t>(first_kept - result.m_records.begin());
+        result.m_records.erase(result.m_records.begin(), first_kept);
+        return result;
+    }
+
+    /** Replays the timelines of all slots and collects the lock holds, returns the number of gaps **/
+    uint64_t replay(const std::vector<queue_trace_record> & records, std::vector<hold> & holds) {
+        struct slot_state {
+            uint8_t m_state { 0 };
+            uint32_t m_thread { 0 };
+            uint64_t m_since { 0 };
+            bool m_known { false };
+        };
+
+        std::map<uint64_t, slot_state> slots {};
+        uint64_t gaps { 0 };
+        for (const auto & record : records) {
+            auto & slot = slots[record.m_slot];
+            if (slot.m_known && slot.m_state != record.m_from) {
+                ++gaps;
+            } else if (slot.m_known && locked(slot.m_state)) {
+                holds.push_back({
+                    record.m_slot, slot.m_thread, static_cast<queue_slot_state>(slot.m_state), slot.m_since,
+                    record.m_tsc - slot.m_since, true
+                });
+            }
+            slot = { record.m_to, record.m_thread, record.m_tsc, true };
+        }
+
+        const auto last = records.empty() ? 0 : records.back().m_tsc;
+        for (const auto & [id, slot] : slots) {
+            if (locked(slot.m_state)) {
+                holds.push_back({
+                    id, slot.m_thread, static_cast<queue_slot_state>(slot.m_state), slot.m_since, last - slot.m_since,
+                    false
+                });
+            }
+        }
+        return gaps;
+    }
+
+    std::string slot_name(const uint64_t id) {
+        std::ostringstream stream {};
+        stream << "0x" << std::hex << id;
+        return stream.str();
+    }
+
+    void print_distribution(const std::vector<hold> & holds, const queue_slot_state state, const double scale) {
+        std::vector<uint64_t> ticks {};
+        for (const auto & item : holds) {
+            if (item.m_state == state) {
+                ticks.push_back(item.m_ticks);
+            }
+        }
+        std::cout << "   " << std::setw(11) << std::left << name(static_cast<uint8_t>(state)) << std::right << " | ";
+        if (ticks.empty()) {
+            std::cout << "no holds\n";
+            return;
+        }
+        std::ranges::sort(ticks);
+        const auto ns = [& ticks, scale] (const double q) {
+            const auto index = static_cast<size_t>(q * static_cast<double>(ticks.size() - 1));
+            return static_cast<uint64_t>(static_cast<double>(ticks[index]) * scale);
+        };
+        std::cout
+            << std::setw(10) << ticks.size() << " | " << std::setw(8) << ns(0.5) << " | " << std::setw(8) << ns(0.99)
+            << " | " << std::setw(9) << ns(0.999) << " | " << std::setw(12) << ns(1.0) << '\n';
+    }
+
+    void print_timeline(const trace & source, const uint64_t id, const double scale) {
+        const auto origin = source.m_records.empty() ? 0 : source.m_records.front().m_tsc;
+        std::cout << thick_separator << "   Timeline of slot " << slot_name(id) << '\n' << thin_separator;
+        for (const auto & record : source.m_records) {
+            if (record.m_slot == id) {
+                const auto offset = static_cast<uint64_t>(static_cast<double>(record.m_tsc - origin) * scale);
+                std::cout
+                    << "   " << std::setw(14) << offset << " ns | thread " << std::setw(4) << record.m_thread << " | "
+                    << std::setw(11) << name(record.m_from) << " -> " << name(record.m_to) << '\n';
+            }
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+    std::string path {};
+    size_t top { 20 };
+    std::optional<uint64_t> timeline {};
+
+    for (int i { 1 }; i < argc; ++i) {
+        const std::string_view arg { argv[i] };
+        if (arg.starts_with("--top=")) {
+            top = std::strtoull(arg.data() + 6, nullptr, 10);
+        } else if (arg.starts_with("--slot=")) {
+            timeline = std::strtoull(arg.data() + 7, nullptr, 0);
+        } else if (path.empty() && !arg.starts_with("--")) {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " FILE [--top=N] [--slot=ID]\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto source = read_trace(path);
+    if (!source) {
+        std::cerr << "Can't read trace " << path << '\n';
+        return EXIT_FAILURE;
+    }
+
+    const double scale { source->m_header.m_ticks_per_ns > 0.0 ? 1.0 / source->m_header.m_ticks_per_ns : 1.0 };
+    const auto & records = source->m_records;
+    std::vector<hold> holds {};
+    const auto gaps = replay(records, holds);
+    const auto origin = records.empty() ? 0 : records.front().m_tsc;
+    const auto span = records.empty() ? 0 : records.back().m_tsc - origin;
+    std::vector<uint32_t> threads {};
+    for (const auto & record : records) {
+        threads.push_back(record.m_thread);
+    }
+    std::ranges::sort(threads);
+    threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+
+    std::cout
+        << thick_separator
+        << "   Records: " << records.size() << ", threads: " << threads.size() << ", rings: "
+        << source->m_header.m_rings << ", span: " << static_cast<uint64_t>(static_cast<double>(span) * scale)
+        << " ns, gaps: " << gaps << ", dropped before the common window: " << source->m_dropped << '\n'
+        << thick_separator
+        << "   LOCK STATE  |   HOLDS    | P50 NS   | P99 NS   | P99.9 NS  | MAX NS\n"
+        << thin_separator;
+    print_distribution(holds, queue_slot_state::prod_locked, scale);
+    print_distribution(holds, queue_slot_state::cons_locked, scale);
+
+    std::ranges::sort(holds, std::ranges::greater {}, &hold::m_ticks);
+    std::cout
+        << thick_separator
+        << "   LONGEST HOLDS (* STILL HELD AT THE END OF THE TRACE)\n"
+        << "   SLOT               | STATE       | THREAD | START NS       | HELD NS\n"
+        << thin_separator;
+    for (size_t i { 0 }; i < std::min(top, holds.size()); ++i) {
+        const auto & item = holds[i];
+        std::cout
+            << "   " << std::setw(18) << std::left << slot_name(item.m_slot) << " | " << std::setw(11)
+            << name(static_cast<uint8_t>(item.m_state)) << std::right << " | " << std::setw(6) << item.m_thread
+            << " | " << std::setw(14) << static_cast<uint64_t>(static_cast<double>(item.m_start - origin) * scale)
+            << " | " << std::setw(12) << static_cast<uint64_t>(static_cast<double>(item.m_ticks) * scale)
+            << (item.m_released ? "" : " *") << '\n';
+    }
+
+    if (timeline) {
+        print_timeline(*source, *timeline, scale);
+    }
+
+    std::cout << thick_separator;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <xtxn/bounded_fast_mpmc_queue.hpp>
+#include <xtxn/fast_mpmc_queue_stats.hpp>
+#include <xtxn/fast_mpmc_queue_delivery.hpp>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace xtxn;
+
+TEST(lib_bounded_fast_mpmc_queue, queue_of_primitive) {
+    bounded_fast_mpmc_queue<int> queue { 40 };
+    EXPECT_EQ(queue.capacity(), 40);
+
+    for (int i = 50; i; --i) {
+        auto slot = queue.producer_slot();
+        if (i > 10) {
+            EXPECT_TRUE(static_cast<bool>(slot));
+        } else {
+            EXPECT_FALSE(static_cast<bool>(slot));
+        }
+        if (slot) {
+            *slot = i;
+        }
+    }
+
+    for (int i = 50; i; --i) {
+        auto slot = queue.consumer_slot();
+        if (i > 10) {
+            EXPECT_TRUE(static_cast<bool>(slot));
+        } else {
+            EXPECT_FALSE(static_cast<bool>(slot));
+        }
+        if (slot) {
+            EXPECT_TRUE(*slot == i);
+        }
+    }
+}
+
+TEST(lib_bounded_fast_mpmc_queue, queue_of_struct) {
+    struct payload {
+        std::string m_str {};
+        int m_int { 0 };
+    };
+
+    bounded_fast_mpmc_queue<payload> queue { 40 };
+
+    for (int i = 50; i; --i) {
+        auto slot = queue.producer_slot();
+        EXPECT_EQ(static_cast<bool>(slot), i > 10);
+        if (slot) {
+            slot->m_str.assign("long enough to be allocated on the heap, item ");
+            slot->m_str.append(std::to_string(i));
+            slot->m_int = i;
+        }
+    }
+
+    for (int i = 50; i > 20; --i) {
+        auto slot = queue.consumer_slot();
+        EXPECT_EQ(static_cast<bool>(slot), i > 10);
+        if (slot) {
+            EXPECT_TRUE(slot->m_str.ends_with(" " + std::to_string(i)));
+            EXPECT_TRUE((*slot).m_int == i);
+        }
+    }
+
+    EXPECT_FALSE(queue.empty());
+}
+
+TEST(lib_bounded_fast_mpmc_queue, wrap_around) {
+    for (const int capacity : { 2, 3, 7, 37, 1'000 }) {
+        bounded_fast_mpmc_queue<int> queue { capacity };
+        for (int round = 0; round < 5; ++round) {
+            for (int i = 0; i < capacity; ++i) {
+                auto slot = queue.producer_slot();
+                EXPECT_TRUE(static_cast<bool>(slot));
+                if (slot) {
+                    *slot = round * capacity + i;
+                }
+            }
+            EXPECT_FALSE(static_cast<bool>(queue.producer_slot()));
+            for (int i = 0; i < capacity; ++i) {
+                auto slot = queue.consumer_slot();
+                EXPECT_TRUE(static_cast<bool>(slot));
+                if (slot) {
+                    EXPECT_EQ(*slot, round * capacity + i);
+                }
+            }
+            EXPECT_TRUE(queue.empty());
+        }
+    }
+}
+
+TEST(lib_bounded_fast_mpmc_queue, memory_options) {
+    bounded_fast_mpmc_queue<int> queue { 100'000, { .m_huge_pages = true, .m_numa_node = 0 } };
+    EXPECT_EQ(queue.capacity(), 100'000);
+
+    for (int i = 100'000; i; --i) {
+        auto slot = queue.producer_slot();
+        EXPECT_TRUE(static_cast<bool>(slot));
+        if (slot) {
+            *slot = i;
+        }
+    }
+
+    long long sum = 0;
+    while (auto slot = queue.consumer_slot(1)) {
+        sum += *slot;
+    }
+
+    EXPECT_EQ(sum, 100'000ll * 100'001ll / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(lib_bounded_fast_mpmc_queue, residence) {
+    bounded_fast_mpmc_queue<int, true, queue_default_attempts, queue_stats<queue_stats_default_shards, true>> queue {
+        20
+    };
+
+    for (int i = 15; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+    }
+
+    for (int i = 15; i; --i) {
+        EXPECT_TRUE(static_cast<bool>(queue.consumer_slot()));
+    }
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.m_producer.m_acquired, 15u);
+    EXPECT_EQ(stats.m_residence.m_count, 15u);
+    EXPECT_LE(stats.m_residence.m_p50, stats.m_residence.m_max);
+}
+
+TEST(lib_bounded_fast_mpmc_queue, lease_and_dead_letter) {
+    bounded_fast_mpmc_queue<int, false, queue_default_attempts, queue_no_stats, queue_lease_policy::timeout, 2> queue {
+        3
+    };
+    queue.lease_duration(chrono::milliseconds { 20 });
+
+    int letters = 0;
+    queue.dead_letter([& letters] (int & item) {
+        letters += item;
+        return true;
+    });
+
+    {
+        auto slot = queue.producer_slot();
+        *slot = 5;
+        slot.complete();
+    }
+
+    unique_ptr<decltype(queue.consumer_slot())> stuck { new auto(queue.consumer_slot(1)) };
+    EXPECT_EQ(stuck->deliveries(), 1u);
+    this_thread::sleep_for(chrono::milliseconds { 30 });
+    EXPECT_EQ(queue.reclaim_expired(), 1);
+
+    EXPECT_EQ(queue.reclaimed_leases(), 1u);
+    EXPECT_FALSE(queue.empty());
+
+    {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_EQ(slot.deliveries(), 2u);
+        stuck.reset();
+        EXPECT_EQ(queue.dead_letters(), 0u);
+        EXPECT_EQ(slot.deliveries(), 2u);
+        EXPECT_EQ(*slot, 5);
+    }
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.dead_letters(), 1u);
+    EXPECT_EQ(letters, 5);
+}
+
+TEST(lib_bounded_fast_mpmc_queue, contiguous) {
+    bounded_fast_mpmc_queue<int> queue { 7 };
+    static_assert(decltype(queue)::c_contiguous);
+
+    const int values[7] { 0, 1, 2, 3, 4, 5, 6 };
+
+    for (int round = 0; round < 3; ++round) {
+        {
+            auto run = queue.reserve_contiguous(4);
+            EXPECT_TRUE(static_cast<bool>(run));
+            std::copy_n(values, 4, run.span().begin());
+        }
+
+        {
+            auto run = queue.reserve_contiguous(3);
+            EXPECT_TRUE(static_cast<bool>(run));
+            std::copy_n(values + 4, 3, run.span().begin());
+        }
+
+        EXPECT_EQ(queue.reserve_contiguous(1, 1).status(), queue_slot_status::full);
+
+        {
+            auto run = queue.consume_contiguous(7, 1);
+            EXPECT_EQ(run.span().size(), 7u);
+            EXPECT_TRUE(std::equal(run.span().begin(), run.span().end(), values));
+        }
+
+        EXPECT_TRUE(queue.empty());
+    }
+}
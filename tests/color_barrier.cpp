@@ -0,0 +1,75 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <xtxn/color_barrier.hpp>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace xtxn;
+
+template<class B>
+void red_after_green() {
+    B barrier {};
+    atomic_bool red_owned { false };
+    auto green = make_unique<green_lock<B>>(barrier);
+
+    {
+        const red_lock<B> attempt { barrier, try_to_lock };
+        EXPECT_FALSE(attempt.owns_lock());
+    }
+
+    jthread red_thread { [&barrier, &red_owned] {
+        const red_lock<B> red { barrier };
+        red_owned.store(true);
+    } };
+
+    this_thread::sleep_for(chrono::milliseconds { 30 });
+    EXPECT_FALSE(red_owned.load());
+    green.reset();
+    red_thread.join();
+    EXPECT_TRUE(red_owned.load());
+
+    const red_lock<B> red { barrier, try_to_lock };
+    EXPECT_TRUE(red.owns_lock());
+}
+
+template<class B>
+void green_after_red() {
+    B barrier {};
+    atomic_bool green_owned { false };
+    auto red = make_unique<red_lock<B>>(barrier);
+
+    jthread green_thread { [&barrier, &green_owned] {
+        const green_lock<B> green { barrier };
+        green_owned.store(true);
+    } };
+
+    this_thread::sleep_for(chrono::milliseconds { 30 });
+    EXPECT_FALSE(green_owned.load());
+    red.reset();
+    green_thread.join();
+    EXPECT_TRUE(green_owned.load());
+}
+
+TEST(lib_color_barrier, red_after_green) {
+    red_after_green<color_barrier>();
+    red_after_green<basic_color_barrier<color_preference::red>>();
+}
+
+TEST(lib_color_barrier, green_after_red) {
+    green_after_red<color_barrier>();
+    green_after_red<basic_color_barrier<color_preference::red>>();
+}
+
+TEST(lib_color_barrier, greens_share) {
+    color_barrier barrier {};
+    const green_lock first { barrier };
+    const green_lock second { barrier };
+    const red_lock red { barrier, try_to_lock };
+    EXPECT_FALSE(red.owns_lock());
+}
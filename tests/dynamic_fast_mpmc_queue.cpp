@@ -1,8 +1,15 @@
 // Copyright (c) 2025-2026 Vitaly Anasenko
 // Distributed under the MIT License, see accompanying file LICENSE.txt
 
+#include <chrono>
 #include <string>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include <xtxn/dynamic_fast_mpmc_queue.hpp>
+#include <xtxn/fast_mpmc_queue_stats.hpp>
+#include <xtxn/fast_mpmc_queue_trace.hpp>
+#include <xtxn/fast_mpmc_queue_delivery.hpp>
 #include <gtest/gtest.h>
 
 using namespace std;
@@ -148,3 +155,249 @@ TEST(lib_dynamic_fast_mpmc_queue, order_test) {
     EXPECT_TRUE(queue.empty());
     EXPECT_TRUE(queue.capacity() == 20);
 }
+
+TEST(lib_dynamic_fast_mpmc_queue, stats) {
+    dynamic_fast_mpmc_queue<
+        int, 10, 2, true, queue_default_attempts, queue_growth_policy::round, queue_stats<>
+    > queue {};
+
+    for (int i = 25; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+    }
+
+    for (int i = 25; i; --i) {
+        auto slot = queue.consumer_slot();
+        EXPECT_TRUE(static_cast<bool>(slot) == (i > 5));
+    }
+
+    queue.stop();
+    EXPECT_FALSE(static_cast<bool>(queue.producer_slot()));
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.m_producer.m_acquired, 20u);
+    EXPECT_EQ(stats.m_producer.m_full, 5u);
+    EXPECT_EQ(stats.m_producer.m_stopped, 1u);
+    EXPECT_EQ(stats.m_producer.m_probes[1], 20u);
+    EXPECT_EQ(stats.m_consumer.m_acquired, 20u);
+    EXPECT_EQ(stats.m_consumer.m_empty, 5u);
+    EXPECT_EQ(stats.m_grows, 1u);
+    EXPECT_EQ(stats.m_grow_failures, 0u);
+}
+
+TEST(lib_dynamic_fast_mpmc_queue, status) {
+    dynamic_fast_mpmc_queue<int, 10, 2> queue {};
+
+    EXPECT_EQ(queue.consumer_slot().status(), queue_slot_status::empty);
+
+    {
+        auto pending = queue.producer_slot();
+        EXPECT_EQ(pending.status(), queue_slot_status::acquired);
+        auto slot = queue.consumer_slot(1);
+        EXPECT_FALSE(static_cast<bool>(slot));
+        EXPECT_EQ(slot.status(), queue_slot_status::contended);
+        *pending = 20;
+    }
+
+    for (int i = 19; i; --i) {
+        auto slot = queue.producer_slot();
+        EXPECT_EQ(slot.status(), queue_slot_status::acquired);
+        *slot = i;
+    }
+
+    EXPECT_EQ(queue.producer_slot().status(), queue_slot_status::full);
+
+    queue.shutdown();
+    EXPECT_EQ(queue.producer_slot().status(), queue_slot_status::stopped);
+    EXPECT_EQ(queue.consumer_slot().status(), queue_slot_status::acquired);
+
+    queue.stop();
+    EXPECT_EQ(queue.consumer_slot().status(), queue_slot_status::stopped);
+}
+
+TEST(lib_dynamic_fast_mpmc_queue, residence) {
+    dynamic_fast_mpmc_queue<
+        int, 10, 2, true, queue_default_attempts, queue_growth_policy::round, queue_stats<queue_stats_default_shards, true>
+    > queue {};
+
+    for (int i = 15; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+    }
+
+    for (int i = 15; i; --i) {
+        EXPECT_TRUE(static_cast<bool>(queue.consumer_slot()));
+    }
+
+    const auto residence = queue.stats().m_residence;
+    EXPECT_EQ(residence.m_count, 15u);
+    EXPECT_LE(residence.m_p50, residence.m_p99);
+    EXPECT_LE(residence.m_p99, residence.m_p999);
+    EXPECT_LE(residence.m_p999, residence.m_max);
+}
+
+TEST(lib_dynamic_fast_mpmc_queue, policies) {
+    const auto check = [] <queue_cursor_policy K, queue_growth_policy G> () {
+        dynamic_fast_mpmc_queue<int, 4, 2, true, queue_default_attempts, G, queue_no_stats, K> queue {};
+        EXPECT_TRUE(queue.c_cursor_policy == K);
+        for (int round = 0; round < 5; ++round) {
+            for (int i = 0; i < 6; ++i) {
+                auto slot = queue.producer_slot();
+                EXPECT_TRUE(static_cast<bool>(slot));
+                if (slot) {
+                    *slot = round * 10 + i;
+                }
+            }
+            int sum = 0;
+            for (int i = 0; i < 6; ++i) {
+                auto slot = queue.consumer_slot();
+                EXPECT_TRUE(static_cast<bool>(slot));
+                if (slot) {
+                    sum += *slot - round * 10;
+                }
+            }
+            EXPECT_TRUE(sum == 15);
+            EXPECT_TRUE(queue.empty());
+            EXPECT_TRUE(queue.capacity() == 8);
+        }
+    };
+
+    check.template operator()<queue_cursor_policy::exchange, queue_growth_policy::call>();
+    check.template operator()<queue_cursor_policy::exchange, queue_growth_policy::round>();
+    check.template operator()<queue_cursor_policy::store, queue_growth_policy::step>();
+    check.template operator()<queue_cursor_policy::cas, queue_growth_policy::call>();
+    check.template operator()<queue_cursor_policy::cas, queue_growth_policy::step>();
+}
+
+TEST(lib_dynamic_fast_mpmc_queue, trace) {
+    dynamic_fast_mpmc_queue<
+        int, 4, 2, true, queue_default_attempts, queue_growth_policy::round, queue_trace<queue_stats<>, 16>
+    > queue {};
+
+    for (int i = 3; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+    }
+
+    for (int i = 3; i; --i) {
+        EXPECT_TRUE(static_cast<bool>(queue.consumer_slot()));
+    }
+
+    const auto records = queue.trace();
+    EXPECT_EQ(records.size(), 12u);
+    EXPECT_EQ(queue.stats().m_producer.m_acquired, 3u);
+
+    using state = queue_slot_state;
+    const auto expected = [] (const queue_trace_record & record, const state from, const state to) {
+        return record.m_from == static_cast<uint8_t>(from) && record.m_to == static_cast<uint8_t>(to);
+    };
+
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(expected(records[i * 2], state::free, state::prod_locked));
+        EXPECT_TRUE(expected(records[i * 2 + 1], state::prod_locked, state::ready));
+        EXPECT_TRUE(expected(records[i * 2 + 6], state::ready, state::cons_locked));
+        EXPECT_TRUE(expected(records[i * 2 + 7], state::cons_locked, state::free));
+        EXPECT_EQ(records[i * 2].m_slot, records[i * 2 + 7].m_slot);
+        EXPECT_LE(records[i * 2].m_tsc, records[i * 2 + 1].m_tsc);
+    }
+
+    for (int i = 5; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+        EXPECT_TRUE(static_cast<bool>(queue.consumer_slot()));
+    }
+
+    EXPECT_EQ(queue.trace().size(), 16u);
+
+    stringstream dump {};
+    EXPECT_TRUE(queue.dump_trace(dump));
+    EXPECT_EQ(dump.str().size(), sizeof(queue_trace_header) + 16 * sizeof(queue_trace_record));
+}
+
+TEST(lib_dynamic_fast_mpmc_queue, lease) {
+    dynamic_fast_mpmc_queue<
+        int, 4, 1, false, queue_default_attempts, queue_growth_policy::round, queue_no_stats,
+        queue_cursor_policy::store, queue_lease_policy::timeout
+    > queue {};
+    queue.lease_duration(chrono::milliseconds { 20 });
+
+    for (int i = 2; i; --i) {
+        auto slot = queue.producer_slot();
+        *slot = i;
+        slot.complete();
+    }
+
+    {
+        auto stuck_producer = queue.producer_slot();
+        auto stuck_consumer = queue.consumer_slot();
+        EXPECT_TRUE(static_cast<bool>(stuck_producer));
+        EXPECT_TRUE(static_cast<bool>(stuck_consumer));
+        EXPECT_EQ(queue.free_slots(), 1);
+        EXPECT_EQ(queue.reclaim_expired(), 0);
+
+        this_thread::sleep_for(chrono::milliseconds { 30 });
+        EXPECT_TRUE(stuck_consumer.renew());
+        EXPECT_EQ(queue.reclaim_expired(), 1);
+        EXPECT_EQ(queue.free_slots(), 2);
+
+        this_thread::sleep_for(chrono::milliseconds { 30 });
+        EXPECT_EQ(queue.reclaim_expired(), 1);
+        EXPECT_FALSE(stuck_consumer.renew());
+        EXPECT_FALSE(stuck_producer.renew());
+        stuck_producer.complete();
+        stuck_consumer.complete();
+    }
+
+    EXPECT_EQ(queue.reclaimed_leases(), 2u);
+    EXPECT_EQ(queue.free_slots(), 2);
+
+    int sum = 0;
+    for (int i = 2; i; --i) {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_TRUE(static_cast<bool>(slot));
+        if (slot) {
+            sum += *slot;
+            slot.complete();
+        }
+    }
+    EXPECT_EQ(sum, 3);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.consumer_slot(1).status(), queue_slot_status::empty);
+}
+
+TEST(lib_dynamic_fast_mpmc_queue, dead_letter) {
+    dynamic_fast_mpmc_queue<
+        string, 4, 1, false, queue_default_attempts, queue_growth_policy::round, queue_no_stats,
+        queue_cursor_policy::store, queue_lease_policy::none, 2
+    > queue {};
+
+    vector<string> letters {};
+    queue.dead_letter([& letters] (string & item) {
+        letters.push_back(std::move(item));
+        return true;
+    });
+
+    for (const auto & value : { "poison", "good" }) {
+        auto slot = queue.producer_slot();
+        *slot = value;
+        slot.complete();
+    }
+
+    int taken = 0;
+    while (auto slot = queue.consumer_slot(1)) {
+        EXPECT_LE(slot.deliveries(), 2u);
+        if (*slot == "good") {
+            slot.complete();
+            ++taken;
+        }
+    }
+
+    EXPECT_EQ(taken, 1);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.dead_letters(), 1u);
+    EXPECT_EQ(letters, vector<string> { "poison" });
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <xtxn/packed_fast_mpmc_queue.hpp>
+#include <xtxn/fast_mpmc_queue_stats.hpp>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace xtxn;
+
+TEST(lib_packed_fast_mpmc_queue, queue_of_primitive) {
+    packed_fast_mpmc_queue<uint32_t, 40> queue {};
+    static_assert(sizeof(queue) < 40 * sizeof(uint64_t) + 4 * false_sharing_align);
+
+    for (uint32_t i = 50; i; --i) {
+        EXPECT_EQ(queue.push(i), i > 10 ? queue_slot_status::acquired : queue_slot_status::full);
+    }
+
+    EXPECT_EQ(queue.free_slots(), 0);
+
+    for (uint32_t i = 50; i; --i) {
+        uint32_t value { 0 };
+        const auto status = queue.pop(value, 1);
+        if (i > 10) {
+            EXPECT_EQ(status, queue_slot_status::acquired);
+            EXPECT_EQ(value, i);
+        } else {
+            EXPECT_EQ(status, queue_slot_status::empty);
+            EXPECT_EQ(value, 0u);
+        }
+    }
+
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(lib_packed_fast_mpmc_queue, small_payloads) {
+    enum class handle : uint16_t { none, first = 0xFFFF };
+    packed_fast_mpmc_queue<handle, 4> queue {};
+
+    EXPECT_EQ(queue.push(handle::first), queue_slot_status::acquired);
+    EXPECT_EQ(queue.push(handle::none), queue_slot_status::acquired);
+
+    handle value { handle::none };
+    EXPECT_EQ(queue.pop(value), queue_slot_status::acquired);
+    EXPECT_EQ(value, handle::first);
+    value = handle::first;
+    EXPECT_EQ(queue.pop(value), queue_slot_status::acquired);
+    EXPECT_EQ(value, handle::none);
+    EXPECT_TRUE(queue.empty());
+
+    packed_fast_mpmc_queue<int32_t, 4> signed_queue {};
+    int32_t number { 0 };
+    EXPECT_EQ(signed_queue.push(-1), queue_slot_status::acquired);
+    EXPECT_EQ(signed_queue.pop(number), queue_slot_status::acquired);
+    EXPECT_EQ(number, -1);
+}
+
+TEST(lib_packed_fast_mpmc_queue, status) {
+    packed_fast_mpmc_queue<uint32_t, 4, queue_default_attempts, queue_stats<>> queue {};
+
+    EXPECT_EQ(queue.push(1), queue_slot_status::acquired);
+    queue.shutdown();
+    EXPECT_FALSE(queue.producing());
+    EXPECT_EQ(queue.push(2), queue_slot_status::stopped);
+
+    uint32_t value { 0 };
+    EXPECT_EQ(queue.pop(value), queue_slot_status::acquired);
+    EXPECT_EQ(queue.pop(value, 1), queue_slot_status::empty);
+    queue.stop();
+    EXPECT_EQ(queue.pop(value, 1), queue_slot_status::stopped);
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.m_producer.m_acquired, 1u);
+    EXPECT_EQ(stats.m_consumer.m_acquired, 1u);
+}
+
+TEST(lib_packed_fast_mpmc_queue, concurrent) {
+    constexpr uint32_t items { 100'000 };
+    constexpr unsigned producers { 2 };
+    constexpr unsigned consumers { 2 };
+
+    packed_fast_mpmc_queue<uint32_t, 64> queue {};
+    atomic_uint64_t sum { 0 };
+    atomic_uint32_t consumed { 0 };
+
+    {
+        vector<jthread> pool {};
+        for (unsigned p = 0; p < producers; ++p) {
+            pool.emplace_back([& queue, p] {
+                for (uint32_t i = p; i < items; i += producers) {
+                    while (queue.push(i + 1) != queue_slot_status::acquired) {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (unsigned c = 0; c < consumers; ++c) {
+            pool.emplace_back([& queue, & sum, & consumed] {
+                while (consumed.load() < items) {
+                    if (uint32_t value { 0 }; queue.pop(value, 1) == queue_slot_status::acquired) {
+                        sum.fetch_add(value);
+                        consumed.fetch_add(1);
+                    } else {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+    }
+
+    EXPECT_EQ(sum.load(), uint64_t { items } * (items + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2026 Vitaly Anasenko
+// Distributed under the MIT License, see accompanying file LICENSE.txt
+
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <xtxn/small_fast_mpmc_queue.hpp>
+#include <xtxn/static_fast_mpmc_queue.hpp>
+#include <xtxn/fast_mpmc_queue_stats.hpp>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace xtxn;
+
+TEST(lib_small_fast_mpmc_queue, queue_of_primitive) {
+    small_fast_mpmc_queue<int, 40> queue {};
+    static_assert(sizeof(queue) < sizeof(static_fast_mpmc_queue<int, 40>));
+
+    for (int i = 50; i; --i) {
+        auto slot = queue.producer_slot();
+        EXPECT_EQ(static_cast<bool>(slot), i > 10);
+        if (slot) {
+            *slot = i;
+        }
+    }
+
+    EXPECT_EQ(queue.free_slots(), 0);
+
+    for (int i = 50; i; --i) {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_EQ(static_cast<bool>(slot), i > 10);
+        if (slot) {
+            EXPECT_EQ(*slot, i);
+        }
+    }
+
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(lib_small_fast_mpmc_queue, queue_of_struct) {
+    struct payload {
+        std::string m_str {};
+        int m_int { 0 };
+    };
+
+    small_fast_mpmc_queue<payload, 64> queue {};
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 64; ++i) {
+            auto slot = queue.producer_slot();
+            EXPECT_TRUE(static_cast<bool>(slot));
+            if (slot) {
+                slot->m_str.assign("long enough to be allocated on the heap, item ");
+                slot->m_str.append(std::to_string(i));
+                slot->m_int = i;
+            }
+        }
+
+        EXPECT_EQ(queue.producer_slot().status(), queue_slot_status::full);
+
+        for (int i = 0; i < 64; ++i) {
+            auto slot = queue.consumer_slot(1);
+            EXPECT_TRUE(static_cast<bool>(slot));
+            if (slot) {
+                EXPECT_TRUE(slot->m_str.ends_with(" " + std::to_string(i)));
+                EXPECT_EQ(slot->m_int, i);
+            }
+        }
+
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(lib_small_fast_mpmc_queue, status) {
+    small_fast_mpmc_queue<int, 4, false, queue_default_attempts, queue_stats<>> queue {};
+
+    {
+        auto slot = queue.producer_slot();
+        *slot = 1;
+    }
+
+    EXPECT_TRUE(queue.empty());
+
+    {
+        auto slot = queue.producer_slot();
+        *slot = 2;
+        slot.complete();
+    }
+
+    {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_EQ(*slot, 2);
+    }
+
+    EXPECT_EQ(queue.free_slots(), 3);
+
+    {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_EQ(*slot, 2);
+        slot.complete();
+    }
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.consumer_slot(1).status(), queue_slot_status::empty);
+
+    queue.shutdown();
+    EXPECT_EQ(queue.producer_slot().status(), queue_slot_status::stopped);
+    queue.stop();
+    EXPECT_EQ(queue.consumer_slot(1).status(), queue_slot_status::stopped);
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.m_producer.m_acquired, 2u);
+    EXPECT_EQ(stats.m_consumer.m_acquired, 2u);
+}
+
+TEST(lib_small_fast_mpmc_queue, concurrent) {
+    constexpr int64_t items { 100'000 };
+    constexpr unsigned producers { 2 };
+    constexpr unsigned consumers { 2 };
+
+    small_fast_mpmc_queue<int64_t, 8> queue {};
+    atomic_int64_t sum { 0 };
+    atomic_int64_t consumed { 0 };
+
+    {
+        vector<jthread> pool {};
+        for (unsigned p = 0; p < producers; ++p) {
+            pool.emplace_back([& queue, p] {
+                for (int64_t i = p; i < items; i += producers) {
+                    while (true) {
+                        if (auto slot = queue.producer_slot(); slot) {
+                            *slot = i + 1;
+                            break;
+                        }
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (unsigned c = 0; c < consumers; ++c) {
+            pool.emplace_back([& queue, & sum, & consumed] {
+                while (consumed.load() < items) {
+                    if (auto slot = queue.consumer_slot(1); slot) {
+                        sum.fetch_add(*slot);
+                        consumed.fetch_add(1);
+                    } else {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+    }
+
+    EXPECT_EQ(sum.load(), items * (items + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
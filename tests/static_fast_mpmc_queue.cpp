@@ -1,8 +1,16 @@
 // Copyright (c) 2025-2026 Vitaly Anasenko
 // Distributed under the MIT License, see accompanying file LICENSE.txt
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <string>
+#include <sstream>
+#include <thread>
 #include <xtxn/static_fast_mpmc_queue.hpp>
+#include <xtxn/fast_mpmc_queue_stats.hpp>
+#include <xtxn/fast_mpmc_queue_trace.hpp>
+#include <xtxn/fast_mpmc_queue_delivery.hpp>
 #include <gtest/gtest.h>
 
 using namespace std;
@@ -148,3 +156,453 @@ TEST(lib_static_fast_mpmc_queue, order_test) {
     EXPECT_TRUE(queue.empty());
     EXPECT_TRUE(queue.capacity() == 20);
 }
+
+TEST(lib_static_fast_mpmc_queue, stats) {
+    static_fast_mpmc_queue<int, 20, true, queue_default_attempts, queue_stats<>> queue {};
+
+    for (int i = 30; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+    }
+
+    for (int i = 25; i; --i) {
+        auto slot = queue.consumer_slot();
+        EXPECT_TRUE(static_cast<bool>(slot) == (i > 5));
+    }
+
+    queue.stop();
+    EXPECT_FALSE(static_cast<bool>(queue.producer_slot()));
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.m_producer.m_acquired, 20u);
+    EXPECT_EQ(stats.m_producer.m_full, 10u);
+    EXPECT_EQ(stats.m_producer.m_stopped, 1u);
+    EXPECT_EQ(stats.m_producer.m_contended, 0u);
+    EXPECT_EQ(stats.m_producer.m_cas_failures, 0u);
+    EXPECT_EQ(stats.m_producer.m_probes[1], 20u);
+    EXPECT_EQ(stats.m_consumer.m_acquired, 20u);
+    EXPECT_EQ(stats.m_consumer.m_empty, 5u);
+    EXPECT_EQ(stats.m_consumer.m_probes[1], 20u);
+    EXPECT_EQ(stats.m_grows, 0u);
+}
+
+TEST(lib_static_fast_mpmc_queue, status) {
+    static_fast_mpmc_queue<int, 20> queue {};
+
+    EXPECT_EQ(queue.consumer_slot().status(), queue_slot_status::empty);
+
+    {
+        auto pending = queue.producer_slot();
+        EXPECT_EQ(pending.status(), queue_slot_status::acquired);
+        auto slot = queue.consumer_slot(1);
+        EXPECT_FALSE(static_cast<bool>(slot));
+        EXPECT_EQ(slot.status(), queue_slot_status::contended);
+        *pending = 20;
+    }
+
+    for (int i = 19; i; --i) {
+        auto slot = queue.producer_slot();
+        EXPECT_EQ(slot.status(), queue_slot_status::acquired);
+        *slot = i;
+    }
+
+    EXPECT_EQ(queue.producer_slot().status(), queue_slot_status::full);
+
+    queue.shutdown();
+    EXPECT_EQ(queue.producer_slot().status(), queue_slot_status::stopped);
+    EXPECT_EQ(queue.consumer_slot().status(), queue_slot_status::acquired);
+
+    queue.stop();
+    EXPECT_EQ(queue.consumer_slot().status(), queue_slot_status::stopped);
+}
+
+TEST(lib_static_fast_mpmc_queue, residence) {
+    static_fast_mpmc_queue<int, 20, true, queue_default_attempts, queue_stats<queue_stats_default_shards, true>> queue {};
+
+    for (int i = 15; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+    }
+
+    for (int i = 15; i; --i) {
+        EXPECT_TRUE(static_cast<bool>(queue.consumer_slot()));
+    }
+
+    const auto residence = queue.stats().m_residence;
+    EXPECT_EQ(residence.m_count, 15u);
+    EXPECT_LE(residence.m_p50, residence.m_p99);
+    EXPECT_LE(residence.m_p99, residence.m_p999);
+    EXPECT_LE(residence.m_p999, residence.m_max);
+}
+
+TEST(lib_static_fast_mpmc_queue, policies) {
+    const auto check = [] <wrap_policy W> () {
+        static_fast_mpmc_queue<int, 7, true, queue_default_attempts, queue_no_stats, W> queue {};
+        EXPECT_TRUE(queue.c_wrap_policy == W);
+        for (int round = 0; round < 5; ++round) {
+            for (int i = 0; i < 5; ++i) {
+                auto slot = queue.producer_slot();
+                EXPECT_TRUE(static_cast<bool>(slot));
+                if (slot) {
+                    *slot = round * 10 + i;
+                }
+            }
+            for (int i = 0; i < 5; ++i) {
+                auto slot = queue.consumer_slot();
+                EXPECT_TRUE(static_cast<bool>(slot));
+                if (slot) {
+                    EXPECT_TRUE(*slot == round * 10 + i);
+                }
+            }
+            EXPECT_TRUE(queue.empty());
+        }
+    };
+
+    check.template operator()<wrap_policy::modulo>();
+    check.template operator()<wrap_policy::reduce>();
+    check.template operator()<wrap_policy::subtract>();
+}
+
+TEST(lib_static_fast_mpmc_queue, trace) {
+    static_fast_mpmc_queue<int, 4, true, queue_default_attempts, queue_trace<queue_stats<>, 16>> queue {};
+
+    for (int i = 3; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+    }
+
+    for (int i = 3; i; --i) {
+        EXPECT_TRUE(static_cast<bool>(queue.consumer_slot()));
+    }
+
+    const auto records = queue.trace();
+    EXPECT_EQ(records.size(), 12u);
+    EXPECT_EQ(queue.stats().m_producer.m_acquired, 3u);
+
+    using state = queue_slot_state;
+    const auto expected = [] (const queue_trace_record & record, const state from, const state to) {
+        return record.m_from == static_cast<uint8_t>(from) && record.m_to == static_cast<uint8_t>(to);
+    };
+
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(expected(records[i * 2], state::free, state::prod_locked));
+        EXPECT_TRUE(expected(records[i * 2 + 1], state::prod_locked, state::ready));
+        EXPECT_TRUE(expected(records[i * 2 + 6], state::ready, state::cons_locked));
+        EXPECT_TRUE(expected(records[i * 2 + 7], state::cons_locked, state::free));
+        EXPECT_EQ(records[i * 2].m_slot, records[i * 2 + 7].m_slot);
+        EXPECT_LE(records[i * 2].m_tsc, records[i * 2 + 1].m_tsc);
+    }
+
+    for (int i = 5; i; --i) {
+        if (auto slot = queue.producer_slot(); slot) {
+            *slot = i;
+        }
+        EXPECT_TRUE(static_cast<bool>(queue.consumer_slot()));
+    }
+
+    EXPECT_EQ(queue.trace().size(), 16u);
+
+    stringstream dump {};
+    EXPECT_TRUE(queue.dump_trace(dump));
+    EXPECT_EQ(dump.str().size(), sizeof(queue_trace_header) + 16 * sizeof(queue_trace_record));
+}
+
+TEST(lib_static_fast_mpmc_queue, lease) {
+    static_assert(queue_leasable_payload<int, queue_lease_policy::timeout>);
+    static_assert(!queue_leasable_payload<std::string, queue_lease_policy::timeout>);
+    static_assert(queue_leasable_payload<std::string, queue_lease_policy::none>);
+
+    static_fast_mpmc_queue<
+        int, 4, false, queue_default_attempts, queue_no_stats, wrap_policy::subtract, queue_lease_policy::timeout
+    > queue {};
+    queue.lease_duration(chrono::milliseconds { 20 });
+
+    for (int i = 2; i; --i) {
+        auto slot = queue.producer_slot();
+        *slot = i;
+        slot.complete();
+    }
+
+    {
+        auto stuck_producer = queue.producer_slot();
+        auto stuck_consumer = queue.consumer_slot();
+        EXPECT_TRUE(static_cast<bool>(stuck_producer));
+        EXPECT_TRUE(static_cast<bool>(stuck_consumer));
+        EXPECT_EQ(queue.free_slots(), 1);
+        EXPECT_EQ(queue.reclaim_expired(), 0);
+
+        this_thread::sleep_for(chrono::milliseconds { 30 });
+        EXPECT_TRUE(stuck_consumer.renew());
+        EXPECT_EQ(queue.reclaim_expired(), 1);
+        EXPECT_EQ(queue.free_slots(), 2);
+
+        this_thread::sleep_for(chrono::milliseconds { 30 });
+        EXPECT_EQ(queue.reclaim_expired(), 1);
+        EXPECT_FALSE(stuck_consumer.renew());
+        EXPECT_FALSE(stuck_producer.renew());
+        stuck_producer.complete();
+        stuck_consumer.complete();
+    }
+
+    EXPECT_EQ(queue.reclaimed_leases(), 2u);
+    EXPECT_EQ(queue.free_slots(), 2);
+
+    int sum = 0;
+    for (int i = 2; i; --i) {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_TRUE(static_cast<bool>(slot));
+        if (slot) {
+            sum += *slot;
+            slot.complete();
+        }
+    }
+    EXPECT_EQ(sum, 3);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.consumer_slot(1).status(), queue_slot_status::empty);
+}
+
+TEST(lib_static_fast_mpmc_queue, lease_trace) {
+    static_fast_mpmc_queue<
+        int, 4, false, queue_default_attempts, queue_trace<queue_no_stats, 16>, wrap_policy::subtract,
+        queue_lease_policy::timeout
+    > queue {};
+    queue.lease_duration(chrono::milliseconds { 20 });
+
+    {
+        auto slot = queue.producer_slot();
+        *slot = 1;
+        slot.complete();
+    }
+
+    {
+        auto stuck_consumer = queue.consumer_slot();
+        EXPECT_TRUE(static_cast<bool>(stuck_consumer));
+        this_thread::sleep_for(chrono::milliseconds { 30 });
+        EXPECT_EQ(queue.reclaim_expired(), 1);
+        stuck_consumer.complete();
+    }
+
+    EXPECT_EQ(queue.trace().size(), 4u);
+
+    {
+        auto slot = queue.consumer_slot();
+        EXPECT_EQ(*slot, 1);
+        slot.complete();
+    }
+
+    using state = queue_slot_state;
+    const auto records = queue.trace();
+    EXPECT_EQ(records.size(), 6u);
+    EXPECT_EQ(records[3].m_from, static_cast<uint8_t>(state::cons_locked));
+    EXPECT_EQ(records[3].m_to, static_cast<uint8_t>(state::ready));
+    EXPECT_EQ(records[5].m_from, static_cast<uint8_t>(state::cons_locked));
+    EXPECT_EQ(records[5].m_to, static_cast<uint8_t>(state::free));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(lib_static_fast_mpmc_queue, dead_letter) {
+    static_fast_mpmc_queue<int, 4> dead {};
+    static_fast_mpmc_queue<
+        int, 4, false, queue_default_attempts, queue_no_stats, wrap_policy::subtract, queue_lease_policy::none, 3
+    > queue {};
+    queue.dead_letter(queue_dead_letter_sink(dead));
+
+    const auto produce = [] (auto & target, const int value) {
+        auto slot = target.producer_slot();
+        EXPECT_TRUE(static_cast<bool>(slot));
+        if (slot) {
+            *slot = value;
+            slot.complete();
+        }
+    };
+
+    produce(queue, 7);
+    for (unsigned i = 1; i <= 3; ++i) {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_TRUE(static_cast<bool>(slot));
+        EXPECT_EQ(slot.deliveries(), i);
+    }
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.dead_letters(), 1u);
+    EXPECT_EQ(*dead.consumer_slot(1), 7);
+
+    for (int i = 4; i; --i) {
+        produce(dead, 0);
+    }
+    produce(queue, 9);
+    for (unsigned i = 1; i <= 3; ++i) {
+        EXPECT_TRUE(static_cast<bool>(queue.consumer_slot(1)));
+    }
+
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.dead_letters(), 1u);
+
+    EXPECT_TRUE(static_cast<bool>(dead.consumer_slot(1)));
+    {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_EQ(slot.deliveries(), 4u);
+    }
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.dead_letters(), 2u);
+
+    produce(queue, 11);
+    {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_EQ(slot.deliveries(), 1u);
+        EXPECT_EQ(*slot, 11);
+        slot.complete();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(lib_static_fast_mpmc_queue, lease_and_dead_letter) {
+    static_fast_mpmc_queue<
+        int, 4, false, queue_default_attempts, queue_no_stats, wrap_policy::subtract, queue_lease_policy::timeout, 2
+    > queue {};
+    queue.lease_duration(chrono::milliseconds { 20 });
+
+    int letters = 0;
+    queue.dead_letter([& letters] (int & item) {
+        letters += item;
+        item = 0;
+        return true;
+    });
+
+    {
+        auto slot = queue.producer_slot();
+        *slot = 5;
+        slot.complete();
+    }
+
+    unique_ptr<decltype(queue.consumer_slot())> stale { new auto(queue.consumer_slot(1)) };
+    EXPECT_EQ(stale->deliveries(), 1u);
+    this_thread::sleep_for(chrono::milliseconds { 30 });
+    EXPECT_EQ(queue.reclaim_expired(), 1);
+
+    {
+        auto slot = queue.consumer_slot(1);
+        EXPECT_TRUE(static_cast<bool>(slot));
+        EXPECT_EQ(slot.deliveries(), 2u);
+
+        stale.reset();
+        EXPECT_EQ(queue.dead_letters(), 0u);
+        EXPECT_EQ(letters, 0);
+        EXPECT_EQ(slot.deliveries(), 2u);
+        EXPECT_EQ(*slot, 5);
+    }
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.dead_letters(), 1u);
+    EXPECT_EQ(letters, 5);
+}
+
+TEST(lib_static_fast_mpmc_queue, contiguous) {
+    static_fast_mpmc_queue<int, 16> queue {};
+    static_assert(decltype(queue)::c_contiguous);
+    static_assert(!static_fast_mpmc_queue<std::string, 16>::c_contiguous);
+
+    const int values[16] { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    {
+        auto run = queue.reserve_contiguous(10);
+        EXPECT_TRUE(static_cast<bool>(run));
+        EXPECT_EQ(run.span().size(), 10u);
+        std::copy_n(values, 10, run.span().begin());
+    }
+
+    EXPECT_EQ(queue.free_slots(), 6);
+    EXPECT_FALSE(static_cast<bool>(queue.reserve_contiguous(10, 1)));
+
+    {
+        auto run = queue.reserve_contiguous(6);
+        EXPECT_TRUE(static_cast<bool>(run));
+        std::copy_n(values + 10, 6, run.span().begin());
+    }
+
+    {
+        auto run = queue.consume_contiguous(12, 1);
+        EXPECT_TRUE(static_cast<bool>(run));
+        EXPECT_EQ(run.span().size(), 12u);
+        EXPECT_TRUE(std::equal(run.span().begin(), run.span().end(), values));
+    }
+
+    {
+        auto run = queue.consume_contiguous(8, 1);
+        EXPECT_EQ(run.span().size(), 4u);
+        EXPECT_TRUE(std::equal(run.span().begin(), run.span().end(), values + 12));
+    }
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.consume_contiguous(4, 1).status(), queue_slot_status::empty);
+
+    static_fast_mpmc_queue<int, 8, false> manual {};
+
+    {
+        auto run = manual.reserve_contiguous(5);
+        EXPECT_TRUE(static_cast<bool>(run));
+    }
+
+    EXPECT_TRUE(manual.empty());
+
+    {
+        auto run = manual.reserve_contiguous(5);
+        std::copy_n(values, 5, run.span().begin());
+        run.complete();
+    }
+
+    {
+        auto run = manual.consume_contiguous(5, 1);
+        EXPECT_EQ(run.span().size(), 5u);
+    }
+
+    EXPECT_EQ(manual.free_slots(), 3);
+
+    {
+        auto run = manual.consume_contiguous(5, 1);
+        EXPECT_EQ(run.span().size(), 5u);
+        run.complete();
+    }
+
+    EXPECT_TRUE(manual.empty());
+}
+
+TEST(lib_static_fast_mpmc_queue, streaming) {
+    struct payload {
+        int64_t m_words[131] {};
+    };
+
+    static_fast_mpmc_queue<
+        payload, 8, true, queue_default_attempts, queue_no_stats, wrap_policy::subtract, queue_lease_policy::none,
+        queue_unlimited_deliveries, queue_transfer_policy::streaming
+    > queue {};
+    static_assert(decltype(queue)::c_streaming);
+    static_assert(!static_fast_mpmc_queue<
+        std::string, 8, true, queue_default_attempts, queue_no_stats, wrap_policy::subtract, queue_lease_policy::none,
+        queue_unlimited_deliveries, queue_transfer_policy::streaming
+    >::c_streaming);
+
+    for (int64_t i = 0; i < 20; ++i) {
+        {
+            payload item {};
+            for (auto & word : item.m_words) {
+                word = i;
+            }
+            auto slot = queue.producer_slot();
+            EXPECT_TRUE(static_cast<bool>(slot));
+            slot.store(item);
+        }
+
+        auto slot = queue.consumer_slot(1);
+        EXPECT_TRUE(static_cast<bool>(slot));
+        EXPECT_TRUE(std::all_of(std::begin(slot->m_words), std::end(slot->m_words), [i] (auto word) {
+            return word == i;
+        }));
+    }
+
+    EXPECT_TRUE(queue.empty());
+}